@@ -0,0 +1,120 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameActorRegistry.h"
+
+#include "SaveGameObject.h"
+#include "GameFramework/Actor.h"
+
+ENUM_CLASS_FLAGS(FSaveGameActorRegistry::EClassFlags);
+
+bool FSaveGameActorRegistry::Add(AActor* Actor)
+{
+	if (!IsValid(Actor) || !IsSaveable(Actor))
+	{
+		return false;
+	}
+
+	int32& ActorIdx = ActorIndices.FindOrAdd(Actor, INDEX_NONE);
+	if (ActorIdx == INDEX_NONE)
+	{
+		ActorIdx = Actors.Add(Actor);
+		ActorKeys.Add(Actor);
+	}
+
+	return true;
+}
+
+bool FSaveGameActorRegistry::Remove(const AActor* Actor)
+{
+	// The class check is far cheaper than looking the actor up, and most destroyed actors aren't saved
+	if (!Actor || !IsSaveable(Actor))
+	{
+		return false;
+	}
+
+	int32 ActorIdx;
+	if (!ActorIndices.RemoveAndCopyValue(Actor, ActorIdx))
+	{
+		return false;
+	}
+
+	RemoveAt(ActorIdx);
+	return true;
+}
+
+void FSaveGameActorRegistry::RemoveLevelActors(const ULevel* Level, TArray<AActor*>& OutActors)
+{
+	// Iterate backwards, so that the actors that are swapped in have already been checked
+	for (int32 ActorIdx = Actors.Num() - 1; ActorIdx >= 0; --ActorIdx)
+	{
+		AActor* Actor = Actors[ActorIdx].Get();
+
+		if (!Actor || Actor->GetLevel() == Level)
+		{
+			if (Actor)
+			{
+				OutActors.Add(Actor);
+			}
+
+			ActorIndices.Remove(ActorKeys[ActorIdx]);
+			RemoveAt(ActorIdx);
+		}
+	}
+}
+
+void FSaveGameActorRegistry::Reset()
+{
+	Actors.Reset();
+	ActorKeys.Reset();
+	ActorIndices.Reset();
+	ClassFlags.Reset();
+}
+
+bool FSaveGameActorRegistry::IsSaveable(const AActor* Actor)
+{
+	return EnumHasAnyFlags(GetClassFlags(Actor->GetClass()), EClassFlags::SaveGameObject);
+}
+
+bool FSaveGameActorRegistry::IsSpawnActor(const AActor* Actor)
+{
+	return EnumHasAnyFlags(GetClassFlags(Actor->GetClass()), EClassFlags::SpawnActor);
+}
+
+FSaveGameActorRegistry::EClassFlags FSaveGameActorRegistry::GetClassFlags(const UClass* Class)
+{
+	if (const EClassFlags* Flags = ClassFlags.Find(Class))
+	{
+		return *Flags;
+	}
+
+	// Only check each class once
+	EClassFlags Flags = EClassFlags::None;
+
+	if (Class->ImplementsInterface(USaveGameObject::StaticClass()))
+	{
+		Flags |= EClassFlags::SaveGameObject;
+	}
+
+	if (Class->ImplementsInterface(USaveGameSpawnActor::StaticClass()))
+	{
+		Flags |= EClassFlags::SpawnActor;
+	}
+
+	return ClassFlags.Add(Class, Flags);
+}
+
+void FSaveGameActorRegistry::RemoveAt(int32 ActorIdx)
+{
+	const int32 LastIdx = Actors.Num() - 1;
+
+	if (ActorIdx != LastIdx)
+	{
+		// Keep the actor that's moved into the gap findable
+		Actors[ActorIdx] = Actors[LastIdx];
+		ActorKeys[ActorIdx] = ActorKeys[LastIdx];
+		ActorIndices[ActorKeys[ActorIdx]] = ActorIdx;
+	}
+
+	Actors.RemoveAt(LastIdx, 1, EAllowShrinking::No);
+	ActorKeys.RemoveAt(LastIdx, 1, EAllowShrinking::No);
+}
@@ -0,0 +1,63 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * The actors that are saved with the world, packed into a dense array so that they can be iterated quickly.
+ * Removing an actor moves the last actor into its place, so the order of the actors isn't stable.
+ *
+ * Whether a class implements the save game interfaces is only checked once, so actors that aren't saved (i.e.
+ * projectiles) only cost a class lookup when they're spawned or destroyed.
+ */
+struct FSaveGameActorRegistry
+{
+	/** Adds an actor if its class implements ISaveGameObject, returns false if it doesn't */
+	bool Add(AActor* Actor);
+
+	/** Removes an actor, returns false if it wasn't registered */
+	bool Remove(const AActor* Actor);
+
+	/** Removes the actors that belong to a level, adding them to OutActors. Also drops any actors that are gone. */
+	void RemoveLevelActors(const ULevel* Level, TArray<AActor*>& OutActors);
+
+	/** Forgets all actors and cached classes */
+	void Reset();
+
+	/** Whether the actor's class implements ISaveGameObject */
+	bool IsSaveable(const AActor* Actor);
+
+	/** Whether the actor's class implements ISaveGameSpawnActor */
+	bool IsSpawnActor(const AActor* Actor);
+
+	/** The registered actors, which may include actors that have since been garbage collected */
+	TConstArrayView<TWeakObjectPtr<AActor>> GetActors() const
+	{
+		return Actors;
+	}
+
+private:
+	enum class EClassFlags : uint8
+	{
+		None = 0,
+		SaveGameObject = 1 << 0,
+		SpawnActor = 1 << 1
+	};
+	FRIEND_ENUM_CLASS_FLAGS(EClassFlags);
+
+	EClassFlags GetClassFlags(const UClass* Class);
+
+	void RemoveAt(int32 ActorIdx);
+
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	/** The key of each actor in Actors, so that actors can still be removed after they've been garbage collected */
+	TArray<FObjectKey> ActorKeys;
+
+	/** Where each registered actor is in Actors */
+	TMap<FObjectKey, int32> ActorIndices;
+
+	TMap<FObjectKey, EClassFlags> ClassFlags;
+};
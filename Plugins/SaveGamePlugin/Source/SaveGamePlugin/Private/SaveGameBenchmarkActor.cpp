@@ -0,0 +1,53 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameBenchmarkActor.h"
+
+#include "SaveGameFunctionLibrary.h"
+#include "Components/SceneComponent.h"
+
+ASaveGameBenchmarkActor::ASaveGameBenchmarkActor()
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void ASaveGameBenchmarkActor::Randomize(FRandomStream& Random, int32 PayloadSize, AActor* InTarget)
+{
+	static const FName States[] = { TEXT("Idle"), TEXT("Moving"), TEXT("Attacking"), TEXT("Dead") };
+
+	Health = Random.RandRange(0, 100);
+	Velocity = Random.GetUnitVector() * Random.FRandRange(0.0, 3000.0);
+	State = States[Random.RandHelper(UE_ARRAY_COUNT(States))];
+	Target = InTarget;
+	Counter = Random.RandRange(0, MAX_int32);
+
+	Payload.SetNumUninitialized(PayloadSize);
+	for (uint8& Byte : Payload)
+	{
+		// Only half of each byte is random, so that the payload compresses like real data would
+		Byte = static_cast<uint8>(Random.RandHelper(16));
+	}
+
+	SetActorLocationAndRotation(Random.GetUnitVector() * Random.FRandRange(0.0, 100000.0), Random.GetUnitVector().Rotation());
+
+	// Moving the actor has already marked it, but its properties and Counter aren't tracked
+	USaveGameFunctionLibrary::MarkActorSaveDirty(this);
+}
+
+bool ASaveGameBenchmarkActor::OnSerialize_Implementation(FSaveGameArchive& Archive, bool bIsLoading)
+{
+	USaveGameFunctionLibrary::SerializeActorTransform(Archive, this);
+
+	Archive.SerializeField(TEXT("Counter"), [this](FStructuredArchive::FSlot Slot)
+	{
+		Slot << Counter;
+	});
+
+	return true;
+}
+
+bool ASaveGameBenchmarkSpawnActor::SetSpawnID_Implementation(const FGuid& NewID)
+{
+	SpawnID = NewID;
+	return true;
+}
@@ -0,0 +1,69 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGameObject.h"
+#include "GameFramework/Actor.h"
+#include "SaveGameBenchmarkActor.generated.h"
+
+/**
+ * A synthetic actor for USaveGameBenchmarkCommandlet, shaped like a typical gameplay actor (i.e. a projectile or a
+ * pickup): a handful of SaveGame properties, a variable sized payload, an optional reference to another actor, and
+ * its transform and some extra state written in OnSerialize.
+ */
+UCLASS(Transient, NotPlaceable, HideDropdown)
+class ASaveGameBenchmarkActor : public AActor, public ISaveGameObject
+{
+	GENERATED_BODY()
+
+public:
+	ASaveGameBenchmarkActor();
+
+	/** Fills the actor's state with random data */
+	void Randomize(FRandomStream& Random, int32 PayloadSize, AActor* InTarget);
+
+	virtual bool OnSerialize_Implementation(FSaveGameArchive& Archive, bool bIsLoading) override;
+
+	UPROPERTY(SaveGame)
+	int32 Health = 0;
+
+	UPROPERTY(SaveGame)
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY(SaveGame)
+	FName State;
+
+	UPROPERTY(SaveGame)
+	TArray<uint8> Payload;
+
+	UPROPERTY(SaveGame)
+	TObjectPtr<AActor> Target;
+
+	/** Only written in OnSerialize */
+	int64 Counter = 0;
+};
+
+/** A benchmark actor that can be serialized on worker threads */
+UCLASS(Transient, NotPlaceable, HideDropdown)
+class ASaveGameBenchmarkParallelActor : public ASaveGameBenchmarkActor
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool CanSerializeOnAnyThread() const override { return true; }
+};
+
+/** A benchmark actor that's mapped by its SpawnID, rather than being spawned again */
+UCLASS(Transient, NotPlaceable, HideDropdown)
+class ASaveGameBenchmarkSpawnActor : public ASaveGameBenchmarkActor, public ISaveGameSpawnActor
+{
+	GENERATED_BODY()
+
+public:
+	virtual const FGuid GetSpawnID_Implementation() const override { return SpawnID; }
+	virtual bool SetSpawnID_Implementation(const FGuid& NewID) override;
+
+	UPROPERTY()
+	FGuid SpawnID;
+};
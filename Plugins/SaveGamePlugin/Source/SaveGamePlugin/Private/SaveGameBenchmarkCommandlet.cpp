@@ -0,0 +1,259 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameBenchmarkCommandlet.h"
+
+#include "SaveGameBenchmarkActor.h"
+#include "SaveGamePhaseStats.h"
+#include "SaveGamePlugin.h"
+#include "SaveGameSerializer.h"
+#include "SaveGameSubsystem.h"
+
+#include "EngineUtils.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Engine/GameInstance.h"
+#include "Misc/FileHelper.h"
+
+#define BENCHMARK_SAVE_NAME TEXT("SaveGameBenchmark")
+
+/** Fills the world with benchmark actors */
+static void SpawnBenchmarkActors(UWorld* World, FRandomStream& Random, const FString& Params)
+{
+	int32 NumActors = 10000;
+	int32 PayloadBytes = 64;
+	float ParallelRatio = 0.25f;
+	float SpawnIDRatio = 0.05f;
+	float ReferenceRatio = 0.25f;
+
+	FParse::Value(*Params, TEXT("Actors="), NumActors);
+	FParse::Value(*Params, TEXT("PayloadBytes="), PayloadBytes);
+	FParse::Value(*Params, TEXT("ParallelRatio="), ParallelRatio);
+	FParse::Value(*Params, TEXT("SpawnIDRatio="), SpawnIDRatio);
+	FParse::Value(*Params, TEXT("ReferenceRatio="), ReferenceRatio);
+
+	TArray<ASaveGameBenchmarkActor*> Actors;
+	Actors.Reserve(NumActors);
+
+	for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+	{
+		const float ClassRoll = Random.GetFraction();
+
+		TSubclassOf<ASaveGameBenchmarkActor> ActorClass = ASaveGameBenchmarkActor::StaticClass();
+		if (ClassRoll < SpawnIDRatio)
+		{
+			ActorClass = ASaveGameBenchmarkSpawnActor::StaticClass();
+		}
+		else if (ClassRoll < SpawnIDRatio + ParallelRatio)
+		{
+			ActorClass = ASaveGameBenchmarkParallelActor::StaticClass();
+		}
+
+		ASaveGameBenchmarkActor* Actor = World->SpawnActor<ASaveGameBenchmarkActor>(ActorClass);
+
+		// Only reference actors that already exist, like most references to spawned actors would be
+		AActor* Target = !Actors.IsEmpty() && Random.GetFraction() < ReferenceRatio ? Actors[Random.RandHelper(Actors.Num())] : nullptr;
+		Actor->Randomize(Random, PayloadBytes, Target);
+
+		if (ASaveGameBenchmarkSpawnActor* SpawnActor = Cast<ASaveGameBenchmarkSpawnActor>(Actor))
+		{
+			SpawnActor->SpawnID = FGuid::NewGuid();
+		}
+
+		Actors.Add(Actor);
+	}
+}
+
+/** Destroys the actors that a load will spawn again, leaving the actors that are mapped by SpawnID */
+static void DestroyBenchmarkActors(UWorld* World)
+{
+	for (TActorIterator<ASaveGameBenchmarkActor> It(World); It; ++It)
+	{
+		if (!It->IsA<ASaveGameBenchmarkSpawnActor>())
+		{
+			It->Destroy();
+		}
+	}
+
+	// Free up the actors' names, as they're spawned again with the same names
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+USaveGameBenchmarkCommandlet::USaveGameBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USaveGameBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumIterations = 3;
+	int32 Seed = 0;
+	FString OutputName = TEXT("SaveGameBenchmark.csv");
+
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Output="), OutputName);
+
+	const TMap<FString, double> Thresholds = ParseThresholds(Params);
+
+	// A standalone game instance gives us a world with a save game subsystem, without needing a map
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	UWorld* World = GameInstance->GetWorld();
+	USaveGameSubsystem* SaveGameSubsystem = GameInstance->GetSubsystem<USaveGameSubsystem>();
+	check(World && SaveGameSubsystem);
+
+	FRandomStream Random(Seed);
+	SpawnBenchmarkActors(World, Random, Params);
+
+	FSaveGameBenchmarkPass SavePass{ TEXT("Save") };
+	FSaveGameBenchmarkPass LoadPass{ TEXT("Load") };
+	bool bSuccess = true;
+
+	for (int32 Iteration = 0; Iteration < NumIterations && bSuccess; ++Iteration)
+	{
+		{
+			TSaveGameSerializer<false> Serializer(SaveGameSubsystem);
+			Serializer.SetSaveName(BENCHMARK_SAVE_NAME);
+			bSuccess &= Serializer.Save();
+			SavePass.Iterations.Add(Serializer.GetPhaseStats());
+		}
+
+		DestroyBenchmarkActors(World);
+
+		{
+			TSaveGameSerializer<true> Serializer(SaveGameSubsystem);
+			Serializer.SetSaveName(BENCHMARK_SAVE_NAME);
+			bSuccess &= Serializer.LoadWithoutTravel();
+			LoadPass.Iterations.Add(Serializer.GetPhaseStats());
+		}
+
+		UE_LOG(LogSaveGame, Display, TEXT("SaveGameBenchmark: Iteration %d, saved in %.2fms, loaded in %.2fms"), Iteration,
+			SavePass.Iterations.Last().GetTotalSeconds() * 1000.0, LoadPass.Iterations.Last().GetTotalSeconds() * 1000.0);
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("SaveGameBenchmark: Failed to save or load the benchmark world"));
+	}
+
+	if (ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem())
+	{
+		SaveSystem->DeleteGame(false, BENCHMARK_SAVE_NAME, 0);
+	}
+
+	GameInstance->Shutdown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GameInstance->RemoveFromRoot();
+
+	if (!bSuccess)
+	{
+		return 1;
+	}
+
+	// Every iteration's phases, then the averages
+	TArray<FString> Lines = { TEXT("Iteration,Pass,Phase,Milliseconds,Bytes,Allocations") };
+
+	for (const FSaveGameBenchmarkPass* Pass : { &SavePass, &LoadPass })
+	{
+		for (int32 Iteration = 0; Iteration < Pass->Iterations.Num(); ++Iteration)
+		{
+			const FSaveGamePhaseStats& Stats = Pass->Iterations[Iteration];
+
+			for (int32 PhaseIdx = 0; PhaseIdx < FSaveGamePhaseStats::NumPhases; ++PhaseIdx)
+			{
+				Lines.Add(FString::Printf(TEXT("%d,%s,%s,%.3f,%lld,%lld"), Iteration, Pass->Name, FSaveGamePhaseStats::GetPhaseName(static_cast<ESaveGamePhase>(PhaseIdx)),
+					Stats.Seconds[PhaseIdx] * 1000.0, Stats.Bytes[PhaseIdx], Stats.Allocations[PhaseIdx]));
+			}
+		}
+
+		for (int32 PhaseIdx = 0; PhaseIdx < FSaveGamePhaseStats::NumPhases; ++PhaseIdx)
+		{
+			Lines.Add(FString::Printf(TEXT("Average,%s,%s,%.3f,,"), Pass->Name, FSaveGamePhaseStats::GetPhaseName(static_cast<ESaveGamePhase>(PhaseIdx)),
+				Pass->GetAverageMilliseconds(static_cast<ESaveGamePhase>(PhaseIdx))));
+		}
+
+		Lines.Add(FString::Printf(TEXT("Average,%s,Total,%.3f,,"), Pass->Name, Pass->GetAverageMilliseconds(ESaveGamePhase::Num)));
+	}
+
+	const FString OutputPath = FPaths::ProjectSavedDir() / OutputName;
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutputPath))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("SaveGameBenchmark: Couldn't write '%s'"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogSaveGame, Display, TEXT("SaveGameBenchmark: Wrote '%s'"), *OutputPath);
+
+	// Any phase that's slower than its threshold fails the run
+	return CountExceededThresholds(Thresholds, SavePass, LoadPass) > 0 ? 1 : 0;
+}
+
+TMap<FString, double> USaveGameBenchmarkCommandlet::ParseThresholds(const FString& Params)
+{
+	TMap<FString, double> Thresholds;
+
+	FString ThresholdsParam;
+	if (FParse::Value(*Params, TEXT("Thresholds="), ThresholdsParam, false))
+	{
+		TArray<FString> Pairs;
+		ThresholdsParam.ParseIntoArray(Pairs, TEXT(","));
+
+		for (const FString& Pair : Pairs)
+		{
+			FString Name, Milliseconds;
+			if (Pair.Split(TEXT("="), &Name, &Milliseconds))
+			{
+				Thresholds.Add(Name.TrimStartAndEnd(), FCString::Atod(*Milliseconds));
+			}
+			else
+			{
+				UE_LOG(LogSaveGame, Warning, TEXT("SaveGameBenchmark: Ignoring threshold '%s', expected Pass.Phase=Milliseconds"), *Pair);
+			}
+		}
+	}
+
+	return Thresholds;
+}
+
+int32 USaveGameBenchmarkCommandlet::CountExceededThresholds(const TMap<FString, double>& Thresholds, const FSaveGameBenchmarkPass& SavePass, const FSaveGameBenchmarkPass& LoadPass)
+{
+	int32 NumExceeded = 0;
+
+	for (const TPair<FString, double>& Threshold : Thresholds)
+	{
+		FString PassName, PhaseName;
+		Threshold.Key.Split(TEXT("."), &PassName, &PhaseName);
+
+		const FSaveGameBenchmarkPass* Pass = PassName == SavePass.Name ? &SavePass : PassName == LoadPass.Name ? &LoadPass : nullptr;
+
+		ESaveGamePhase Phase = ESaveGamePhase::Num;
+		for (int32 PhaseIdx = 0; PhaseIdx < FSaveGamePhaseStats::NumPhases; ++PhaseIdx)
+		{
+			if (PhaseName == FSaveGamePhaseStats::GetPhaseName(static_cast<ESaveGamePhase>(PhaseIdx)))
+			{
+				Phase = static_cast<ESaveGamePhase>(PhaseIdx);
+			}
+		}
+
+		if (!Pass || (Phase == ESaveGamePhase::Num && PhaseName != TEXT("Total")))
+		{
+			UE_LOG(LogSaveGame, Warning, TEXT("SaveGameBenchmark: Unknown threshold '%s'"), *Threshold.Key);
+			continue;
+		}
+
+		const double Milliseconds = Pass->GetAverageMilliseconds(Phase);
+		if (Milliseconds > Threshold.Value)
+		{
+			UE_LOG(LogSaveGame, Error, TEXT("SaveGameBenchmark: %s took %.3fms, over its threshold of %.3fms"), *Threshold.Key, Milliseconds, Threshold.Value);
+			++NumExceeded;
+		}
+	}
+
+	return NumExceeded;
+}
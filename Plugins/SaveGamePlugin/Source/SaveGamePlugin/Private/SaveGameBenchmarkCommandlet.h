@@ -0,0 +1,61 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGamePhaseStats.h"
+#include "Commandlets/Commandlet.h"
+#include "SaveGameBenchmarkCommandlet.generated.h"
+
+/** A pass (Save or Load) of every iteration */
+struct FSaveGameBenchmarkPass
+{
+	const TCHAR* Name;
+	TArray<FSaveGamePhaseStats> Iterations;
+
+	/** The average milliseconds of a phase across every iteration, or of the whole pass if Phase is Num */
+	double GetAverageMilliseconds(ESaveGamePhase Phase) const
+	{
+		double Seconds = 0.0;
+		for (const FSaveGamePhaseStats& Stats : Iterations)
+		{
+			Seconds += Phase == ESaveGamePhase::Num ? Stats.GetTotalSeconds() : Stats.GetSeconds(Phase);
+		}
+
+		return Seconds * 1000.0 / FMath::Max(Iterations.Num(), 1);
+	}
+};
+
+/**
+ * Saves and loads a synthetic world, measuring each phase of the save and load (see ESaveGamePhase), so that
+ * performance regressions can be caught by automation. Runs headless, i.e. with -nullrhi.
+ *
+ * Usage: -run=SaveGameBenchmark [-Actors=10000] [-Iterations=3] [-PayloadBytes=64] [-ParallelRatio=0.25]
+ *		[-SpawnIDRatio=0.05] [-ReferenceRatio=0.25] [-Seed=0] [-Output=SaveGameBenchmark.csv]
+ *		[-Thresholds=Save.Actors=50,Load.Total=200]
+ *
+ * - Actors: The number of actors in the world
+ * - PayloadBytes: The size of each actor's payload property
+ * - ParallelRatio: The share of actors that can be serialized on worker threads
+ * - SpawnIDRatio: The share of actors that are mapped by SpawnID (these aren't destroyed before loading)
+ * - ReferenceRatio: The share of actors that reference another actor
+ * - Output: The CSV of every iteration's phases, relative to the project's Saved directory. The allocation counts are
+ *	 approximate, as they include allocations made by other threads (see FSaveGamePhaseStats::Allocations).
+ * - Thresholds: The maximum average milliseconds of a pass's phase (or Total), the run fails if any are exceeded
+ */
+UCLASS()
+class USaveGameBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USaveGameBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/** Parses the -Thresholds param's "Pass.Phase=Milliseconds" pairs, separated by commas */
+	static TMap<FString, double> ParseThresholds(const FString& Params);
+
+	/** The number of thresholds whose pass's phase (or Total) averaged slower than it, unknown thresholds are skipped */
+	static int32 CountExceededThresholds(const TMap<FString, double>& Thresholds, const FSaveGameBenchmarkPass& SavePass, const FSaveGameBenchmarkPass& LoadPass);
+};
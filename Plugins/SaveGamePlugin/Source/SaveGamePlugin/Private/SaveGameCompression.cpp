@@ -0,0 +1,246 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameCompression.h"
+
+#include "Async/ParallelFor.h"
+#include "Compression/OodleDataCompression.h"
+#include "Misc/Compression.h"
+
+#include <atomic>
+
+static FName GetFormatName(ESaveGameCompressionCodec Codec)
+{
+	switch (Codec)
+	{
+	case ESaveGameCompressionCodec::Oodle:
+		return NAME_Oodle;
+	case ESaveGameCompressionCodec::LZ4:
+		return NAME_LZ4;
+	case ESaveGameCompressionCodec::Zlib:
+		return NAME_Zlib;
+	case ESaveGameCompressionCodec::Gzip:
+		return NAME_Gzip;
+	default:
+		return NAME_None;
+	}
+}
+
+static ECompressionFlags GetCompressionFlags(ESaveGameCompressionLevel Level)
+{
+	switch (Level)
+	{
+	case ESaveGameCompressionLevel::Fastest:
+	case ESaveGameCompressionLevel::Fast:
+		return COMPRESS_BiasSpeed;
+	case ESaveGameCompressionLevel::Optimal:
+	case ESaveGameCompressionLevel::Maximum:
+		return COMPRESS_BiasSize;
+	default:
+		return COMPRESS_NoFlags;
+	}
+}
+
+static FOodleDataCompression::ECompressor GetOodleCompressor(ESaveGameCompressionLevel Level)
+{
+	switch (Level)
+	{
+	case ESaveGameCompressionLevel::Fastest:
+		return FOodleDataCompression::ECompressor::Selkie;
+	case ESaveGameCompressionLevel::Fast:
+		return FOodleDataCompression::ECompressor::Mermaid;
+	case ESaveGameCompressionLevel::Maximum:
+		return FOodleDataCompression::ECompressor::Leviathan;
+	default:
+		return FOodleDataCompression::ECompressor::Kraken;
+	}
+}
+
+static FOodleDataCompression::ECompressionLevel GetOodleCompressionLevel(ESaveGameCompressionLevel Level)
+{
+	switch (Level)
+	{
+	case ESaveGameCompressionLevel::Fastest:
+		return FOodleDataCompression::ECompressionLevel::SuperFast;
+	case ESaveGameCompressionLevel::Fast:
+		return FOodleDataCompression::ECompressionLevel::VeryFast;
+	case ESaveGameCompressionLevel::Optimal:
+		return FOodleDataCompression::ECompressionLevel::Optimal2;
+	case ESaveGameCompressionLevel::Maximum:
+		return FOodleDataCompression::ECompressionLevel::Optimal3;
+	default:
+		return FOodleDataCompression::ECompressionLevel::Normal;
+	}
+}
+
+bool FSaveGameCompression::Compress(const FSaveGameCompressionSettings& Settings, TConstArrayView<uint8> UncompressedData, TArray<uint8>& OutCompressedData)
+{
+	const int32 StartOffset = OutCompressedData.Num();
+	
+	switch (Settings.Codec)
+	{
+	case ESaveGameCompressionCodec::None:
+		{
+			OutCompressedData.Append(UncompressedData.GetData(), UncompressedData.Num());
+			return true;
+		}
+	case ESaveGameCompressionCodec::Oodle:
+		{
+			// Oodle is called directly, as FCompression doesn't let us choose the compressor or level
+			const int64 CompressedBufferSize = FOodleDataCompression::CompressedBufferSizeNeeded(UncompressedData.Num());
+
+			// Our arrays are indexed by int32, blocks are nowhere near this big unless the block size is misconfigured
+			if (CompressedBufferSize > MAX_int32 - StartOffset)
+			{
+				return false;
+			}
+			
+			OutCompressedData.AddUninitialized(static_cast<int32>(CompressedBufferSize));
+
+			const int64 CompressedSize = FOodleDataCompression::Compress(OutCompressedData.GetData() + StartOffset, CompressedBufferSize,
+				UncompressedData.GetData(), UncompressedData.Num(), GetOodleCompressor(Settings.Level), GetOodleCompressionLevel(Settings.Level));
+
+			// Compress returns zero on failure, and never more than the buffer it was given
+			OutCompressedData.SetNum(StartOffset + static_cast<int32>(FMath::Clamp<int64>(CompressedSize, 0, CompressedBufferSize)));
+			return CompressedSize > 0;
+		}
+	default:
+		{
+			const FName FormatName = GetFormatName(Settings.Codec);
+			
+			int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, UncompressedData.Num());
+			OutCompressedData.AddUninitialized(CompressedSize);
+
+			const bool bSuccess = FCompression::CompressMemory(FormatName, OutCompressedData.GetData() + StartOffset, CompressedSize,
+				UncompressedData.GetData(), UncompressedData.Num(), GetCompressionFlags(Settings.Level));
+
+			OutCompressedData.SetNum(StartOffset + (bSuccess ? CompressedSize : 0));
+			return bSuccess;
+		}
+	}
+}
+
+bool FSaveGameCompression::Decompress(ESaveGameCompressionCodec Codec, TConstArrayView<uint8> CompressedData, TArrayView<uint8> OutUncompressedData)
+{
+	switch (Codec)
+	{
+	case ESaveGameCompressionCodec::None:
+		{
+			if (CompressedData.Num() != OutUncompressedData.Num())
+			{
+				return false;
+			}
+
+			FMemory::Memcpy(OutUncompressedData.GetData(), CompressedData.GetData(), CompressedData.Num());
+			return true;
+		}
+	case ESaveGameCompressionCodec::Oodle:
+		{
+			return FOodleDataCompression::Decompress(OutUncompressedData.GetData(), OutUncompressedData.Num(),
+				CompressedData.GetData(), CompressedData.Num());
+		}
+	case ESaveGameCompressionCodec::LZ4:
+	case ESaveGameCompressionCodec::Zlib:
+	case ESaveGameCompressionCodec::Gzip:
+		{
+			return FCompression::UncompressMemory(GetFormatName(Codec), OutUncompressedData.GetData(), OutUncompressedData.Num(),
+				CompressedData.GetData(), CompressedData.Num());
+		}
+	default:
+		{
+			// Unknown codec, likely a corrupt file header
+			return false;
+		}
+	}
+}
+
+void FSaveGameCompression::CompressBlock(const FSaveGameCompressionSettings& Settings, TConstArrayView<uint8> Block, TArray<uint8>& OutCompressedBlock)
+{
+	OutCompressedBlock.Reset();
+
+	// Store the block as is if it failed, or didn't benefit from compression
+	if (!Compress(Settings, Block, OutCompressedBlock) || OutCompressedBlock.Num() >= Block.Num())
+	{
+		OutCompressedBlock.Reset();
+		OutCompressedBlock.Append(Block.GetData(), Block.Num());
+	}
+}
+
+void FSaveGameCompression::CompressBlocks(const FSaveGameCompressionSettings& Settings, int32 BlockSize, TConstArrayView<uint8> UncompressedData, TArray<int32>& OutBlockSizes, TArray<uint8>& OutCompressedData)
+{
+	check(BlockSize > 0);
+	
+	const int32 NumBlocks = FMath::DivideAndRoundUp(UncompressedData.Num(), BlockSize);
+
+	TArray<TArray<uint8>> CompressedBlocks;
+	CompressedBlocks.SetNum(NumBlocks);
+
+	ParallelFor(NumBlocks, [&](int32 BlockIdx)
+	{
+		CompressBlock(Settings, UncompressedData.Mid(BlockIdx * BlockSize, BlockSize), CompressedBlocks[BlockIdx]);
+	});
+
+	OutBlockSizes.Reset(NumBlocks);
+
+	int64 TotalSize = 0;
+	for (const TArray<uint8>& CompressedBlock : CompressedBlocks)
+	{
+		TotalSize += CompressedBlock.Num();
+	}
+	
+	OutCompressedData.Reserve(OutCompressedData.Num() + static_cast<int32>(TotalSize));
+
+	for (const TArray<uint8>& CompressedBlock : CompressedBlocks)
+	{
+		OutBlockSizes.Add(CompressedBlock.Num());
+		OutCompressedData.Append(CompressedBlock);
+	}
+}
+
+bool FSaveGameCompression::DecompressBlocks(ESaveGameCompressionCodec Codec, int32 BlockSize, TConstArrayView<int32> BlockSizes, TConstArrayView<uint8> CompressedData, TArrayView<uint8> OutUncompressedData)
+{
+	if (BlockSize <= 0 || BlockSizes.Num() != FMath::DivideAndRoundUp(OutUncompressedData.Num(), BlockSize))
+	{
+		return false;
+	}
+	
+	// Find where each block starts, so they can be decompressed independently
+	TArray<int64> BlockOffsets;
+	BlockOffsets.Reserve(BlockSizes.Num());
+
+	int64 Offset = 0;
+	for (const int32 CompressedSize : BlockSizes)
+	{
+		if (CompressedSize < 0)
+		{
+			return false;
+		}
+		
+		BlockOffsets.Add(Offset);
+		Offset += CompressedSize;
+	}
+
+	if (Offset != CompressedData.Num())
+	{
+		return false;
+	}
+
+	std::atomic<bool> bSuccess = true;
+
+	ParallelFor(BlockSizes.Num(), [&](int32 BlockIdx)
+	{
+		const TConstArrayView<uint8> CompressedBlock = CompressedData.Mid(static_cast<int32>(BlockOffsets[BlockIdx]), BlockSizes[BlockIdx]);
+		const TArrayView<uint8> Block = OutUncompressedData.Mid(BlockIdx * BlockSize, BlockSize);
+
+		// This block wasn't compressed
+		if (CompressedBlock.Num() == Block.Num())
+		{
+			FMemory::Memcpy(Block.GetData(), CompressedBlock.GetData(), Block.Num());
+		}
+		else if (!Decompress(Codec, CompressedBlock, Block))
+		{
+			bSuccess = false;
+		}
+	});
+
+	return bSuccess;
+}
@@ -0,0 +1,69 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "SaveGameSettings.h"
+
+/**
+ * Compresses and decompresses save game data with any of the codecs that are selectable in USaveGameSettings.
+ * The codec isn't stored in the compressed data, it's up to the caller to store it (i.e. in FSaveGameFileHeader).
+ *
+ * Save data is split into fixed-size blocks that are compressed independently, so that they can be compressed and
+ * decompressed in parallel. A block that doesn't compress is stored as is, which is detected on decompression by
+ * its compressed size matching its uncompressed size.
+ */
+struct FSaveGameCompression
+{
+	/**
+	 * Compresses data in independent blocks, in parallel.
+	 *
+	 * @param Settings The codec and level to compress with
+	 * @param BlockSize The uncompressed size of each block, the last block may be smaller
+	 * @param UncompressedData The data to compress
+	 * @param OutBlockSizes The compressed size of each block
+	 * @param OutCompressedData Each compressed block is appended to this array, one after the other
+	 */
+	static void CompressBlocks(const FSaveGameCompressionSettings& Settings, int32 BlockSize, TConstArrayView<uint8> UncompressedData, TArray<int32>& OutBlockSizes, TArray<uint8>& OutCompressedData);
+
+	/**
+	 * Compresses a single block, as CompressBlocks does for each of its blocks.
+	 * The block is stored as is if it failed to compress, or didn't benefit from compression.
+	 *
+	 * @param Settings The codec and level to compress with
+	 * @param Block The data to compress
+	 * @param OutCompressedBlock Set to the compressed block
+	 */
+	static void CompressBlock(const FSaveGameCompressionSettings& Settings, TConstArrayView<uint8> Block, TArray<uint8>& OutCompressedBlock);
+
+	/**
+	 * Decompresses data that was compressed with CompressBlocks, in parallel.
+	 *
+	 * @param Codec The codec that the data was compressed with
+	 * @param BlockSize The uncompressed size of each block
+	 * @param BlockSizes The compressed size of each block
+	 * @param CompressedData The compressed blocks
+	 * @param OutUncompressedData Must already be sized to the data's uncompressed size
+	 * @return true if every block was successfully decompressed
+	 */
+	static bool DecompressBlocks(ESaveGameCompressionCodec Codec, int32 BlockSize, TConstArrayView<int32> BlockSizes, TConstArrayView<uint8> CompressedData, TArrayView<uint8> OutUncompressedData);
+
+	/**
+	 * Compresses data with the specified codec and level.
+	 * 
+	 * @param Settings The codec and level to compress with
+	 * @param UncompressedData The data to compress
+	 * @param OutCompressedData The compressed data is appended to this array
+	 * @return false if the codec failed to compress, OutCompressedData will be unchanged
+	 */
+	static bool Compress(const FSaveGameCompressionSettings& Settings, TConstArrayView<uint8> UncompressedData, TArray<uint8>& OutCompressedData);
+
+	/**
+	 * Decompresses data that was compressed with the specified codec.
+	 * 
+	 * @param Codec The codec that the data was compressed with
+	 * @param CompressedData The data to decompress
+	 * @param OutUncompressedData Must already be sized to the data's uncompressed size
+	 * @return true if the data was successfully decompressed
+	 */
+	static bool Decompress(ESaveGameCompressionCodec Codec, TConstArrayView<uint8> CompressedData, TArrayView<uint8> OutUncompressedData);
+};
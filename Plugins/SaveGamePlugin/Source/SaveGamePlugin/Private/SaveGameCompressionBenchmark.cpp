@@ -0,0 +1,115 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameCompression.h"
+#include "SaveGameFileHeader.h"
+#include "SaveGamePlugin.h"
+
+#include "HAL/IConsoleManager.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+
+/**
+ * Compares every codec and level against an existing save, so that USaveGameSettings can be tuned with real data.
+ * Usage: SaveGame.BenchmarkCompression [SaveName] [Iterations]
+ */
+static void BenchmarkCompression(const TArray<FString>& Args)
+{
+	const FString SaveName = Args.IsValidIndex(0) ? Args[0] : TEXT("SaveGame");
+	const int32 NumIterations = Args.IsValidIndex(1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 5;
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	TArray<uint8> FileData;
+	if (!SaveSystem || !SaveSystem->LoadGame(false, *SaveName, 0, FileData))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("BenchmarkCompression: Couldn't read save '%s'"), *SaveName);
+		return;
+	}
+
+	// Get the save's payload as it was before being compressed
+	FSaveGameFileHeader FileHeader;
+	TConstArrayView<uint8> CompressedBlocks;
+
+	if (!FileHeader.Read(FileData, CompressedBlocks))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("BenchmarkCompression: '%s' isn't a valid save"), *SaveName);
+		return;
+	}
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(FileHeader.UncompressedSize);
+
+	if (!FSaveGameCompression::DecompressBlocks(FileHeader.Codec, FileHeader.BlockSize, FileHeader.BlockSizes, CompressedBlocks, Payload))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("BenchmarkCompression: Failed to decompress '%s'"), *SaveName);
+		return;
+	}
+
+	// Benchmark with the block size that saves will actually be made with
+	const int32 BlockSize = GetDefault<USaveGameSettings>()->GetCompressionBlockSize();
+
+	UE_LOG(LogSaveGame, Display, TEXT("BenchmarkCompression: '%s', %d bytes uncompressed, %d byte blocks, %d iterations"), *SaveName, Payload.Num(), BlockSize, NumIterations);
+	UE_LOG(LogSaveGame, Display, TEXT("%-8s %-8s %12s %8s %14s %14s"), TEXT("Codec"), TEXT("Level"), TEXT("Bytes"), TEXT("Ratio"), TEXT("Compress MB/s"), TEXT("Decompress MB/s"));
+
+	const UEnum* CodecEnum = StaticEnum<ESaveGameCompressionCodec>();
+	const UEnum* LevelEnum = StaticEnum<ESaveGameCompressionLevel>();
+
+	// Skip the autogenerated _MAX entries
+	for (int32 CodecIdx = 0; CodecIdx < CodecEnum->NumEnums() - 1; ++CodecIdx)
+	{
+		for (int32 LevelIdx = 0; LevelIdx < LevelEnum->NumEnums() - 1; ++LevelIdx)
+		{
+			const FSaveGameCompressionSettings Settings(
+				static_cast<ESaveGameCompressionCodec>(CodecEnum->GetValueByIndex(CodecIdx)),
+				static_cast<ESaveGameCompressionLevel>(LevelEnum->GetValueByIndex(LevelIdx)));
+
+			// Only Oodle makes full use of every level, so just benchmark the other codecs once
+			if (Settings.Codec != ESaveGameCompressionCodec::Oodle && Settings.Level != ESaveGameCompressionLevel::Normal)
+			{
+				continue;
+			}
+
+			TArray<int32> BlockSizes;
+			TArray<uint8> Compressed;
+			TArray<uint8> Decompressed;
+			Decompressed.SetNumUninitialized(Payload.Num());
+			
+			double CompressSeconds = 0.0;
+			double DecompressSeconds = 0.0;
+			bool bSuccess = true;
+
+			for (int32 Iteration = 0; Iteration < NumIterations && bSuccess; ++Iteration)
+			{
+				Compressed.Reset();
+
+				double StartTime = FPlatformTime::Seconds();
+				FSaveGameCompression::CompressBlocks(Settings, BlockSize, Payload, BlockSizes, Compressed);
+				CompressSeconds += FPlatformTime::Seconds() - StartTime;
+
+				StartTime = FPlatformTime::Seconds();
+				bSuccess &= FSaveGameCompression::DecompressBlocks(Settings.Codec, BlockSize, BlockSizes, Compressed, Decompressed);
+				DecompressSeconds += FPlatformTime::Seconds() - StartTime;
+			}
+
+			const FString CodecName = CodecEnum->GetNameStringByIndex(CodecIdx);
+			const FString LevelName = LevelEnum->GetNameStringByIndex(LevelIdx);
+
+			if (!bSuccess || Decompressed != Payload)
+			{
+				UE_LOG(LogSaveGame, Warning, TEXT("%-8s %-8s failed to round trip"), *CodecName, *LevelName);
+				continue;
+			}
+
+			const double MegaBytes = double(Payload.Num()) * NumIterations / (1024.0 * 1024.0);
+			
+			UE_LOG(LogSaveGame, Display, TEXT("%-8s %-8s %12d %8.3f %14.1f %14.1f"), *CodecName, *LevelName, Compressed.Num(),
+				double(Compressed.Num()) / FMath::Max(Payload.Num(), 1), MegaBytes / FMath::Max(CompressSeconds, UE_SMALL_NUMBER),
+				MegaBytes / FMath::Max(DecompressSeconds, UE_SMALL_NUMBER));
+		}
+	}
+}
+
+static FAutoConsoleCommand BenchmarkCompressionCommand(
+	TEXT("SaveGame.BenchmarkCompression"),
+	TEXT("Compares the size and speed of each compression codec and level against an existing save. Usage: SaveGame.BenchmarkCompression [SaveName] [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkCompression));
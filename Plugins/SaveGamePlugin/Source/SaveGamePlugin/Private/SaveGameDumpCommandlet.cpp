@@ -0,0 +1,57 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameDumpCommandlet.h"
+
+#include "SaveGamePlugin.h"
+#include "SaveGameSerializer.h"
+
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+
+USaveGameDumpCommandlet::USaveGameDumpCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USaveGameDumpCommandlet::Main(const FString& Params)
+{
+#if WITH_TEXT_ARCHIVE_SUPPORT
+	FString SaveName = TEXT("SaveGame");
+	FParse::Value(*Params, TEXT("Save="), SaveName);
+
+	FString OutputName = SaveName + TEXT(".json");
+	FParse::Value(*Params, TEXT("Output="), OutputName);
+
+	TSaveGameSerializer<true> BinarySerializer(nullptr);
+	if (!BinarySerializer.OpenForRead(SaveName))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("SaveGameDump: Couldn't read save '%s'"), *SaveName);
+		return 1;
+	}
+
+	TArray<uint8> TextData;
+	TSaveGameSerializer<false, true> TextSerializer(nullptr);
+
+	if (!TextSerializer.SaveDump(BinarySerializer, TextData))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("SaveGameDump: Failed to dump save '%s', it may be corrupt"), *SaveName);
+		return 1;
+	}
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || !SaveSystem->SaveGame(false, *OutputName, 0, TextData))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("SaveGameDump: Couldn't write '%s'"), *OutputName);
+		return 1;
+	}
+
+	UE_LOG(LogSaveGame, Display, TEXT("SaveGameDump: Dumped '%s' (map '%s') to '%s', %d bytes"), *SaveName, *BinarySerializer.GetMapName(), *OutputName, TextData.Num());
+	return 0;
+#else
+	UE_LOG(LogSaveGame, Error, TEXT("SaveGameDump: Engine isn't compiled with text archive support"));
+	return 1;
+#endif
+}
@@ -0,0 +1,27 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SaveGameDumpCommandlet.generated.h"
+
+/**
+ * Writes a binary save out as JSON, for debugging what's in a save without having to make a text save at runtime.
+ * Usage: -run=SaveGameDump [-Save=SaveGame] [-Output=SaveGame.json]
+ *
+ * Each actor record is written as it's stored (see TSaveGameSerializer::SaveDump), without loading any of the save's
+ * classes or levels, so the dump shows exactly what the save holds, even for fields that are no longer read.
+ *
+ * The JSON is written through the platform's save game system, alongside the save itself.
+ */
+UCLASS()
+class USaveGameDumpCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USaveGameDumpCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
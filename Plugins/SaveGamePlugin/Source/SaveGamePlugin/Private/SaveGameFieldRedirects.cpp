@@ -0,0 +1,30 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameFieldRedirects.h"
+
+FName FSaveGameFieldRedirects::Find(UClass* Class, FName FieldName)
+{
+	const TPair<FObjectKey, FName> Key(Class, FieldName);
+
+	if (const FName* Redirect = Redirects.Find(Key))
+	{
+		return *Redirect;
+	}
+
+	return Redirects.Add(Key, FindUncached(Class, FieldName));
+}
+
+FName FSaveGameFieldRedirects::FindUncached(UStruct* Struct, FName FieldName)
+{
+	for (UStruct* CheckStruct = Struct; CheckStruct; CheckStruct = CheckStruct->GetSuperStruct())
+	{
+		const FName NewProperty = FProperty::FindRedirectedPropertyName(CheckStruct, FieldName);
+
+		if (!NewProperty.IsNone())
+		{
+			return NewProperty;
+		}
+	}
+
+	return NAME_None;
+}
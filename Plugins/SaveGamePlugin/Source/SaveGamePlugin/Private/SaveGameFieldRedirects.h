@@ -0,0 +1,25 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Remembers which FSaveGameArchive field names have been redirected in CoreRedirects, for each class.
+ *
+ * Finding a redirect means walking the class and all of its super structs, so without this, loading many actors of
+ * the same class would redo the same search for each of them. It's only meant to live for the duration of a load.
+ */
+struct FSaveGameFieldRedirects
+{
+	/** Returns the name that a field of this class has been redirected to, or None if it hasn't been */
+	FName Find(UClass* Class, FName FieldName);
+
+	/** Does the actual search, without remembering the result */
+	static FName FindUncached(UStruct* Struct, FName FieldName);
+
+private:
+	/** Keyed by FObjectKey, as a reinstanced class could reuse the address of one that's been collected */
+	TMap<TPair<FObjectKey, FName>, FName> Redirects;
+};
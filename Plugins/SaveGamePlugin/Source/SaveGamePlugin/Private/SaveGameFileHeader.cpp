@@ -0,0 +1,73 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameFileHeader.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+
+FString FSaveGameFileHeader::GetSlotFilename(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".sav");
+}
+
+bool FSaveGameFileHeader::Peek(const FString& SlotName)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_PeekHeader);
+
+	const TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*GetSlotFilename(SlotName)));
+
+	if (!File)
+	{
+		// Platforms with a save game system of their own don't keep saves as files, so the whole save has to be read
+		ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+		TArray<uint8> FileData;
+		TConstArrayView<uint8> CompressedBlocks;
+		return SaveSystem && SaveSystem->LoadGame(false, *SlotName, 0, FileData) && Read(FileData, CompressedBlocks);
+	}
+
+	// The magic, the version, then the header's size (or the map name's length, in older headers)
+	constexpr int64 PrefixSize = 3 * sizeof(uint32);
+
+	TArray<uint8> HeaderData;
+	HeaderData.SetNumUninitialized(PrefixSize);
+
+	if (!File->Read(HeaderData.GetData(), PrefixSize))
+	{
+		return false;
+	}
+
+	uint32 FileMagic;
+	int32 FileVersion;
+	int32 SizeOrMapNameLength;
+
+	FMemoryReaderView PrefixReader(HeaderData);
+	PrefixReader << FileMagic << FileVersion << SizeOrMapNameLength;
+
+	int64 FileHeaderSize = SizeOrMapNameLength;
+
+	if (FileVersion < FSaveGameVersion::AddedSlotMetadata)
+	{
+		// The map name (negative lengths are UTF-16), followed by the codec, uncompressed size, block size and block table offset
+		const int64 MapNameSize = SizeOrMapNameLength < 0 ? -static_cast<int64>(SizeOrMapNameLength) * sizeof(UTF16CHAR) : SizeOrMapNameLength;
+		FileHeaderSize = PrefixSize + MapNameSize + sizeof(uint8) + sizeof(int64) + sizeof(int32) + sizeof(int64);
+	}
+
+	if (FileMagic != Magic || FileHeaderSize < PrefixSize || FileHeaderSize > File->Size())
+	{
+		return false;
+	}
+
+	HeaderData.SetNumUninitialized(static_cast<int32>(FileHeaderSize));
+
+	if (!File->Read(HeaderData.GetData() + PrefixSize, FileHeaderSize - PrefixSize))
+	{
+		return false;
+	}
+
+	FMemoryReaderView HeaderReader(HeaderData);
+	HeaderReader << *this;
+
+	return !HeaderReader.IsError();
+}
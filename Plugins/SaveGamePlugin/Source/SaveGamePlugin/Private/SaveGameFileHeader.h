@@ -0,0 +1,206 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "SaveGameSettings.h"
+#include "SaveGameVersion.h"
+
+#include "Serialization/Archive.h"
+#include "Serialization/MemoryReader.h"
+
+/**
+ * The uncompressed header at the very start of a binary save file.
+ *
+ * Stores just enough information to start travelling to the save's map, without needing to decompress the rest of
+ * the save. The compressed save game data immediately follows this header, as a series of independently compressed
+ * blocks (see FSaveGameCompression::CompressBlocks), followed by the block table.
+ *
+ * The block table is after the blocks, as a streamed save (see FSaveGameBlockWriter) only knows the size of each
+ * block once it has been written. The header is rewritten at the end of a save, so it must stay the same size, which
+ * means that the map name and slot metadata need to be set before it's first written.
+ *
+ * The fixed size fields come first (including the size of the whole header), so that a slot can be listed by reading
+ * just its header, see Peek.
+ */
+struct FSaveGameFileHeader
+{
+	static constexpr uint32 Magic = 0x53475346; // "FSGS"
+
+	FSaveGameFileHeader()
+		: Version(FSaveGameVersion::LatestVersion)
+		, Codec(ESaveGameCompressionCodec::None)
+		, UncompressedSize(0)
+		, BlockSize(0)
+		, BlockTableOffset(0)
+		, HeaderSize(0)
+		, PlaySeconds(0.0)
+	{}
+
+	explicit FSaveGameFileHeader(const FString& InMapName)
+		: Version(FSaveGameVersion::LatestVersion)
+		, MapName(InMapName)
+		, Codec(ESaveGameCompressionCodec::None)
+		, UncompressedSize(0)
+		, BlockSize(0)
+		, BlockTableOffset(0)
+		, HeaderSize(0)
+		, PlaySeconds(0.0)
+	{}
+
+	/** The FSaveGameVersion this file was written with */
+	int32 Version;
+
+	/** The package name of the map that this save belongs to */
+	FString MapName;
+
+	/** The codec that the rest of the save was compressed with */
+	ESaveGameCompressionCodec Codec;
+
+	/** The size of the save data once decompressed */
+	int64 UncompressedSize;
+
+	/** The uncompressed size of each compressed block */
+	int32 BlockSize;
+
+	/** Where the block table starts in the file, which is also where the compressed blocks end */
+	int64 BlockTableOffset;
+
+	/** The size of this header, which is where the compressed blocks start */
+	uint32 HeaderSize;
+
+	/** When the save was made, in UTC */
+	FDateTime Timestamp;
+
+	/** How long the game had been played for when the save was made, see USaveGameSubsystem::GetPlaySeconds */
+	double PlaySeconds;
+
+	/** The game's own key/values, see USaveGameSubsystem::SetSlotUserData */
+	TMap<FString, FString> UserData;
+
+	/** The compressed size of each block, in the order they're stored. Not serialized with the header, see SerializeBlockTable */
+	TArray<int32> BlockSizes;
+
+	int64 GetCompressedSize() const
+	{
+		return BlockTableOffset - HeaderSize;
+	}
+
+	/** Where the generic (file based) save game system keeps a slot's file */
+	static FString GetSlotFilename(const FString& SlotName);
+
+	/**
+	 * Whether the platform's save game system keeps each slot as a plain file at GetSlotFilename, as the generic one
+	 * on desktop platforms does. Files can be read and written from any thread, other save game systems can only be
+	 * used from the game thread.
+	 */
+	static bool AreSlotsFiles()
+	{
+		return PLATFORM_DESKTOP;
+	}
+
+	/**
+	 * Reads only the header of a slot's file, without reading any of its blocks or its block table.
+	 * @return false if the slot doesn't exist, or isn't a save file that can be read
+	 */
+	bool Peek(const FString& SlotName);
+
+	void SerializeBlockTable(FArchive& Ar)
+	{
+		Ar << BlockSizes;
+	}
+
+	/**
+	 * Reads the header and block table of a save file.
+	 * @param OutCompressedBlocks The compressed blocks, within FileData
+	 * @return false if this isn't a save file that can be read
+	 */
+	bool Read(TConstArrayView<uint8> FileData, TConstArrayView<uint8>& OutCompressedBlocks)
+	{
+		FMemoryReaderView FileReader(FileData);
+		FileReader << *this;
+
+		const int64 BlocksOffset = FileReader.Tell();
+		if (FileReader.IsError() || UncompressedSize < 0 || UncompressedSize > MAX_int32 || BlockTableOffset < BlocksOffset || BlockTableOffset > FileData.Num())
+		{
+			return false;
+		}
+
+		FileReader.Seek(BlockTableOffset);
+		SerializeBlockTable(FileReader);
+
+		if (FileReader.IsError())
+		{
+			return false;
+		}
+
+		OutCompressedBlocks = FileData.Slice(static_cast<int32>(BlocksOffset), static_cast<int32>(BlockTableOffset - BlocksOffset));
+		return true;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FSaveGameFileHeader& Header)
+	{
+		const int64 HeaderPosition = Ar.Tell();
+		
+		uint32 FileMagic = Magic;
+		Ar << FileMagic;
+
+		if (Ar.IsLoading() && FileMagic != Magic)
+		{
+			// Not a save file that we recognize (or one that predates this header)
+			Ar.SetError();
+			return Ar;
+		}
+
+		Ar << Header.Version;
+
+		if (Ar.IsLoading() && (Header.Version < FSaveGameVersion::OldestSupportedVersion || Header.Version > FSaveGameVersion::LatestVersion))
+		{
+			// Either this save is too old to be read, or it's from a newer version of the plugin
+			Ar.SetError();
+			return Ar;
+		}
+		
+		if (Header.Version < FSaveGameVersion::AddedSlotMetadata)
+		{
+			// Older headers only have what's needed to travel and decompress
+			Ar << Header.MapName;
+			Ar << Header.Codec;
+			Ar << Header.UncompressedSize;
+			Ar << Header.BlockSize;
+			Ar << Header.BlockTableOffset;
+
+			Header.HeaderSize = static_cast<uint32>(Ar.Tell() - HeaderPosition);
+			return Ar;
+		}
+
+		// The fixed size fields, only the header's size needs to be read to know how much more to read
+		const int64 HeaderSizePosition = Ar.Tell();
+		Ar << Header.HeaderSize;
+		Ar << Header.Codec;
+		Ar << Header.UncompressedSize;
+		Ar << Header.BlockSize;
+		Ar << Header.BlockTableOffset;
+		Ar << Header.Timestamp;
+		Ar << Header.PlaySeconds;
+
+		// The variable sized fields
+		Ar << Header.MapName;
+		Ar << Header.UserData;
+
+		if (Ar.IsSaving())
+		{
+			const int64 EndPosition = Ar.Tell();
+			Header.HeaderSize = static_cast<uint32>(EndPosition - HeaderPosition);
+
+			Ar.Seek(HeaderSizePosition);
+			Ar << Header.HeaderSize;
+			Ar.Seek(EndPosition);
+		}
+		else if (Ar.Tell() - HeaderPosition != Header.HeaderSize)
+		{
+			Ar.SetError();
+		}
+
+		return Ar;
+	}
+};
@@ -2,7 +2,14 @@
 
 #include "SaveGameFunctionLibrary.h"
 
+#include "SaveGameFileHeader.h"
 #include "SaveGameSettings.h"
+#include "SaveGameSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/GameInstance.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
 
 #if WITH_EDITOR
 #include "Kismet2/KismetEditorUtilities.h"
@@ -49,6 +56,16 @@ bool USaveGameFunctionLibrary::WasObjectLoaded(const UObject* Object)
 	return Object && Object->HasAnyFlags(RF_WasLoaded | RF_LoadCompleted);
 }
 
+void USaveGameFunctionLibrary::MarkActorSaveDirty(AActor* Actor)
+{
+	const UGameInstance* GameInstance = IsValid(Actor) ? Actor->GetGameInstance() : nullptr;
+	
+	if (USaveGameSubsystem* SaveGameSubsystem = GameInstance ? GameInstance->GetSubsystem<USaveGameSubsystem>() : nullptr)
+	{
+		SaveGameSubsystem->MarkSaveDirty(Actor);
+	}
+}
+
 bool USaveGameFunctionLibrary::IsLoading(const FSaveGameArchive& Archive)
 {
 	return Archive.IsValid() && Archive.GetRecord().GetUnderlyingArchive().IsLoading();
@@ -74,7 +91,12 @@ bool USaveGameFunctionLibrary::SerializeActorTransform(FSaveGameArchive& Archive
 			// Serialize the transform
 			Slot << ActorTransform;
 
-			if (bIsLoading && bIsMovable)
+			if (bIsLoading && Archive.GetSpawnTransform() && Actor == Archive.GetObject())
+			{
+				// The archive's actor hasn't finished spawning yet, it'll be spawned with this transform instead
+				*Archive.GetSpawnTransform() = ActorTransform;
+			}
+			else if (bIsLoading && bIsMovable)
 			{
 				// If the actor is movable, set its transform
 				Actor->SetActorTransform(ActorTransform, false, nullptr, ETeleportType::TeleportPhysics);
@@ -157,3 +179,72 @@ int32 USaveGameFunctionLibrary::UseCustomVersion(FSaveGameArchive& Archive, cons
 
 	return INDEX_NONE;
 }
+
+TArray<FSaveGameSlotInfo> USaveGameFunctionLibrary::FindSaveSlots()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_FindSaveSlots);
+	
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	TArray<FString> SlotNames;
+	if (!SaveSystem || !SaveSystem->GetSaveGameNames(SlotNames, 0) || SlotNames.IsEmpty())
+	{
+		return {};
+	}
+
+	// Opening each file is most of the cost, so the slots are read in parallel. Platforms whose saves aren't files
+	// are read through their ISaveGameSystem, which isn't guaranteed to be thread safe.
+	const bool bSavesAreFiles = FSaveGameFileHeader::AreSlotsFiles();
+	
+	TArray<FSaveGameSlotInfo> Slots;
+	Slots.SetNum(SlotNames.Num());
+	
+	TArray<bool> ValidSlots;
+	ValidSlots.SetNumZeroed(SlotNames.Num());
+
+	ParallelFor(SlotNames.Num(), [&](int32 SlotIdx)
+	{
+		ValidSlots[SlotIdx] = PeekSaveSlot(SlotNames[SlotIdx], Slots[SlotIdx]);
+	}, bSavesAreFiles ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	// Anything that isn't a save we can read (i.e. a dump from USaveGameDumpCommandlet) isn't a slot
+	for (int32 SlotIdx = Slots.Num() - 1; SlotIdx >= 0; --SlotIdx)
+	{
+		if (!ValidSlots[SlotIdx])
+		{
+			Slots.RemoveAt(SlotIdx, 1, EAllowShrinking::No);
+		}
+	}
+
+	Slots.Sort([](const FSaveGameSlotInfo& A, const FSaveGameSlotInfo& B)
+	{
+		return A.Timestamp > B.Timestamp;
+	});
+
+	return Slots;
+}
+
+bool USaveGameFunctionLibrary::PeekSaveSlot(const FString& SlotName, FSaveGameSlotInfo& OutSlot)
+{
+	FSaveGameFileHeader FileHeader;
+	if (!FileHeader.Peek(SlotName))
+	{
+		return false;
+	}
+
+	OutSlot.SlotName = SlotName;
+	OutSlot.MapName = FileHeader.MapName;
+	OutSlot.Timestamp = FileHeader.Timestamp;
+	OutSlot.PlaySeconds = FileHeader.PlaySeconds;
+	OutSlot.UserData = FileHeader.UserData;
+	OutSlot.UncompressedSize = FileHeader.UncompressedSize;
+	OutSlot.CompressedSize = FileHeader.GetCompressedSize();
+	OutSlot.Codec = FileHeader.Codec;
+	return true;
+}
+
+bool USaveGameFunctionLibrary::DeleteSaveSlot(const FString& SlotName)
+{
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	return SaveSystem && SaveSystem->DeleteGame(false, *SlotName, 0);
+}
@@ -0,0 +1,82 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameIncrementalCache.h"
+
+#include "GameFramework/Actor.h"
+
+FSaveGameIncrementalCache::~FSaveGameIncrementalCache()
+{
+	Reset();
+}
+
+TConstArrayView<uint8> FSaveGameIncrementalCache::FindData(const AActor* Actor) const
+{
+	const FActorRecord* Record = Records.Find(Actor);
+	return Record ? TConstArrayView<uint8>(Record->Data) : TConstArrayView<uint8>();
+}
+
+void FSaveGameIncrementalCache::AddData(AActor* Actor, TConstArrayView<uint8> ActorData)
+{
+	const FObjectKey ActorKey(Actor);
+	
+	FActorRecord& Record = Records.FindOrAdd(ActorKey);
+	Record.Data.Reset(ActorData.Num());
+	Record.Data.Append(ActorData);
+
+	// Moving any of the actor's components moves its root (or is relative to it), so that's all we need to watch
+	USceneComponent* RootComponent = Actor->GetRootComponent();
+	if (Record.RootComponent != RootComponent)
+	{
+		Unbind(Record);
+
+		if (RootComponent)
+		{
+			Record.RootComponent = RootComponent;
+			Record.TransformUpdatedHandle = RootComponent->TransformUpdated.AddRaw(this, &FSaveGameIncrementalCache::OnTransformUpdated, ActorKey);
+		}
+	}
+}
+
+void FSaveGameIncrementalCache::Invalidate(const AActor* Actor)
+{
+	Remove(Actor);
+}
+
+void FSaveGameIncrementalCache::Reset()
+{
+	Tables.Reset();
+	Versions.Empty();
+	NumSaves = 0;
+
+	for (TPair<FObjectKey, FActorRecord>& Record : Records)
+	{
+		Unbind(Record.Value);
+	}
+	
+	Records.Reset();
+}
+
+void FSaveGameIncrementalCache::OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, FObjectKey ActorKey)
+{
+	Remove(ActorKey);
+}
+
+void FSaveGameIncrementalCache::Remove(FObjectKey ActorKey)
+{
+	if (FActorRecord* Record = Records.Find(ActorKey))
+	{
+		Unbind(*Record);
+		Records.Remove(ActorKey);
+	}
+}
+
+void FSaveGameIncrementalCache::Unbind(FActorRecord& Record)
+{
+	if (USceneComponent* RootComponent = Record.RootComponent.Get())
+	{
+		RootComponent->TransformUpdated.Remove(Record.TransformUpdatedHandle);
+	}
+
+	Record.RootComponent = nullptr;
+	Record.TransformUpdatedHandle.Reset();
+}
@@ -0,0 +1,72 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "SaveGameProxyArchive.h"
+#include "Components/SceneComponent.h"
+#include "Serialization/CustomVersion.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Keeps each actor's serialized data from the previous save, so that actors that haven't changed since can have their
+ * data copied straight into the next save, rather than being serialized again.
+ *
+ * Nothing is compared when saving, an actor's data is simply dropped as soon as the actor is marked dirty: when its
+ * root component's transform is updated, or when USaveGameSubsystem::MarkSaveDirty is called for it, which SaveGame
+ * property setters (and anything else that changes what an actor writes in OnSerialize) need to do. So an unchanged
+ * actor only costs a lookup, no matter how big its data is.
+ *
+ * As the cached data contains indices into the name and path tables, those tables are carried from save to save here
+ * too, which means they also contain entries of actors that no longer exist. To stop them growing forever, the cache
+ * is periodically flushed, so that the next save is a full save.
+ */
+struct FSaveGameIncrementalCache
+{
+	FSaveGameIncrementalCache() = default;
+	~FSaveGameIncrementalCache();
+	
+	/**
+	 * Finds an actor's data from the previous save, if the actor hasn't been marked dirty since.
+	 * Cached data is never empty, as it always contains at least the FSaveGameArchive's field table.
+	 */
+	TConstArrayView<uint8> FindData(const AActor* Actor) const;
+
+	/** Caches an actor's freshly serialized data, until the actor is marked dirty */
+	void AddData(AActor* Actor, TConstArrayView<uint8> ActorData);
+
+	/** Forgets an actor's cached data, so that it's serialized again in the next save */
+	void Invalidate(const AActor* Actor);
+
+	/** Forgets everything, the next save will be a full save */
+	void Reset();
+
+	/** The name and path tables that the cached data indexes into */
+	FSaveGameArchiveTables Tables;
+
+	/** The versions that the cached data was serialized with */
+	FCustomVersionContainer Versions;
+
+	/** How many saves have used the cache since it was last reset */
+	int32 NumSaves = 0;
+
+private:
+	FSaveGameIncrementalCache(const FSaveGameIncrementalCache&) = delete;
+	
+	struct FActorRecord
+	{
+		TArray<uint8> Data;
+
+		/** The actor's root component when its data was cached, whose TransformUpdated invalidates the record */
+		TWeakObjectPtr<USceneComponent> RootComponent;
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	void OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, FObjectKey ActorKey);
+
+	void Remove(FObjectKey ActorKey);
+
+	/** Stops listening for the record's actor moving */
+	static void Unbind(FActorRecord& Record);
+
+	TMap<FObjectKey, FActorRecord> Records;
+};
@@ -2,11 +2,16 @@
 
 #include "SaveGameObject.h"
 
-FSaveGameArchive::FSaveGameArchive(FStructuredArchive::FRecord& InRecord, UObject* InObject)
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "SaveGameFieldRedirects.h"
+
+FSaveGameArchive::FSaveGameArchive(FStructuredArchive::FRecord& InRecord, UObject* InObject, FSaveGameFieldRedirects* InFieldRedirects)
 	: Record(&InRecord)
 	, Object(InObject)
 	, StartPosition(0)
 	, EndPosition(0)
+	, SpawnTransform(nullptr)
 {
 	FArchive& Archive = Record->GetUnderlyingArchive();
 
@@ -23,7 +28,7 @@ FSaveGameArchive::FSaveGameArchive(FStructuredArchive::FRecord& InRecord, UObjec
 
 	// If saving, pre-fill this so that we can fill it on destruct
 	// If loading, use it to immediately serialize our Fields map
-	uint64 FieldsOffset;
+	uint32 FieldsOffset;
 	Archive << FieldsOffset;
 
 	if (Archive.IsLoading())
@@ -31,28 +36,40 @@ FSaveGameArchive::FSaveGameArchive(FStructuredArchive::FRecord& InRecord, UObjec
 		// Go to our fields
 		Archive.Seek(StartPosition + FieldsOffset);
 
-		// Serialize them in
+		// Serialize them in, they're only sorted by name on load as name order isn't stable between sessions
 		Archive << Fields;
+		Algo::SortBy(Fields, &FFieldOffset::Name, FNameFastLess());
 
 		// Store our true end position, so that when we destruct, we can fall off the end gracefully
 		EndPosition = Archive.Tell();
 
 		// If we have any properties that were redirected in CoreRedirects, fix them here
-		for (auto It = Fields.CreateIterator(); It; ++It)
+		// (we might not have an object, i.e. when reading a save with FSaveGameReader)
+		bool bRedirectedFields = false;
+		
+		for (FFieldOffset& Field : Fields)
 		{
-			TPair<FName, uint64>& Field = *It;
-					
-			for (UStruct* CheckStruct = Object->GetClass(); CheckStruct; CheckStruct = CheckStruct->GetSuperStruct())
+			if (!Object.IsValid())
 			{
-				FName NewProperty = FProperty::FindRedirectedPropertyName(CheckStruct, Field.Key);
+				break;
+			}
+
+			UClass* Class = Object->GetClass();
+			const FName NewProperty = InFieldRedirects
+				? InFieldRedirects->Find(Class, Field.Name)
+				: FSaveGameFieldRedirects::FindUncached(Class, Field.Name);
 					
-				if (!NewProperty.IsNone())
-				{
-					Field.Key = NewProperty;
-					break;
-				}
+			if (!NewProperty.IsNone())
+			{
+				Field.Name = NewProperty;
+				bRedirectedFields = true;
 			}
 		}
+
+		if (bRedirectedFields)
+		{
+			Algo::SortBy(Fields, &FFieldOffset::Name, FNameFastLess());
+		}
 	}
 }
 
@@ -78,7 +95,14 @@ FSaveGameArchive::~FSaveGameArchive()
 	
 	if (Archive.IsSaving())
 	{
-		uint64 FieldsOffset = Archive.Tell() - StartPosition;
+		// The field table's offset is stored in 32 bits too, see AddField
+		const uint64 FieldsPosition = Archive.Tell() - StartPosition;
+		if (!ensure(FieldsPosition <= MAX_uint32))
+		{
+			Archive.SetError();
+		}
+		
+		uint32 FieldsOffset = static_cast<uint32>(FieldsPosition);
 		
 		// Store our accrued list of fields and their offsets
 		Archive << Fields;
@@ -93,3 +117,34 @@ FSaveGameArchive::~FSaveGameArchive()
 	// If we had any ordering changes or removals of fields, be sure to continue on from the very end
 	Archive.Seek(EndPosition);
 }
+
+const uint32* FSaveGameArchive::FindField(FName FieldName) const
+{
+	const int32 FieldIdx = Algo::LowerBoundBy(Fields, FieldName, &FFieldOffset::Name, FNameFastLess());
+	
+	if (Fields.IsValidIndex(FieldIdx) && Fields[FieldIdx].Name == FieldName)
+	{
+		return &Fields[FieldIdx].Offset;
+	}
+
+	return nullptr;
+}
+
+bool FSaveGameArchive::AddField(FName FieldName, uint64 Offset)
+{
+	const int32 FieldIdx = Algo::LowerBoundBy(Fields, FieldName, &FFieldOffset::Name, FNameFastLess());
+	
+	if (Fields.IsValidIndex(FieldIdx) && Fields[FieldIdx].Name == FieldName)
+	{
+		return false;
+	}
+
+	// Offsets are relative to the start of this archive, so only a single actor's data would need to exceed this
+	if (!ensure(Offset <= MAX_uint32))
+	{
+		return false;
+	}
+
+	Fields.Insert({ FieldName, static_cast<uint32>(Offset) }, FieldIdx);
+	return true;
+}
@@ -0,0 +1,163 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGamePhaseStats.h"
+
+#include "HAL/MemoryBase.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+LLM_DEFINE_TAG(SaveGame);
+
+UE_TRACE_CHANNEL_DEFINE(SaveGameChannel);
+
+CSV_DEFINE_CATEGORY(SaveGame, true);
+
+UE_TRACE_EVENT_BEGIN(SaveGame, ActorClass)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, Cycles)
+	UE_TRACE_EVENT_FIELD(uint64, Bytes)
+	UE_TRACE_EVENT_FIELD(uint32, NumActors)
+	UE_TRACE_EVENT_FIELD(bool, bIsLoading)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, ClassName)
+UE_TRACE_EVENT_END()
+
+TRACE_DECLARE_INT_COUNTER(SaveGame_Actors, TEXT("SaveGame/Actors"));
+TRACE_DECLARE_MEMORY_COUNTER(SaveGame_SerializedBytes, TEXT("SaveGame/SerializedBytes"));
+TRACE_DECLARE_MEMORY_COUNTER(SaveGame_FileBytes, TEXT("SaveGame/FileBytes"));
+
+const TCHAR* FSaveGamePhaseStats::GetPhaseName(ESaveGamePhase Phase)
+{
+	switch (Phase)
+	{
+	case ESaveGamePhase::Read:
+		return TEXT("Read");
+	case ESaveGamePhase::Decompress:
+		return TEXT("Decompress");
+	case ESaveGamePhase::Header:
+		return TEXT("Header");
+	case ESaveGamePhase::Tables:
+		return TEXT("Tables");
+	case ESaveGamePhase::Classes:
+		return TEXT("Classes");
+	case ESaveGamePhase::Actors:
+		return TEXT("Actors");
+	case ESaveGamePhase::DestroyedActors:
+		return TEXT("DestroyedActors");
+	case ESaveGamePhase::Levels:
+		return TEXT("Levels");
+	case ESaveGamePhase::Compress:
+		return TEXT("Compress");
+	case ESaveGamePhase::Write:
+		return TEXT("Write");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+double FSaveGamePhaseStats::GetTotalSeconds() const
+{
+	double TotalSeconds = 0.0;
+	for (const double PhaseSeconds : Seconds)
+	{
+		TotalSeconds += PhaseSeconds;
+	}
+
+	return TotalSeconds;
+}
+
+double FSaveGamePhaseStats::GetGameThreadSeconds() const
+{
+	// Reading, decompressing, compressing and writing can all happen on worker threads
+	return GetTotalSeconds() - GetSeconds(ESaveGamePhase::Read) - GetSeconds(ESaveGamePhase::Decompress)
+		- GetSeconds(ESaveGamePhase::Compress) - GetSeconds(ESaveGamePhase::Write);
+}
+
+int64 FSaveGamePhaseStats::GetSerializedBytes() const
+{
+	return GetBytes(ESaveGamePhase::Header) + GetBytes(ESaveGamePhase::Tables) + GetBytes(ESaveGamePhase::Actors)
+		+ GetBytes(ESaveGamePhase::DestroyedActors) + GetBytes(ESaveGamePhase::Levels);
+}
+
+FSaveGamePhaseStats& FSaveGamePhaseStats::operator+=(const FSaveGamePhaseStats& Other)
+{
+	for (int32 PhaseIdx = 0; PhaseIdx < NumPhases; ++PhaseIdx)
+	{
+		Seconds[PhaseIdx] += Other.Seconds[PhaseIdx];
+		Bytes[PhaseIdx] += Other.Bytes[PhaseIdx];
+		Allocations[PhaseIdx] += Other.Allocations[PhaseIdx];
+	}
+
+	NumActors += Other.NumActors;
+	return *this;
+}
+
+void FSaveGamePhaseStats::TraceActorClass(const UClass* Class, bool bIsLoading, int32 NumActors, uint64 Cycles, uint64 Bytes)
+{
+	const FString ClassName = Class->GetPathName();
+
+	UE_TRACE_LOG(SaveGame, ActorClass, SaveGameChannel)
+		<< ActorClass.Cycle(FPlatformTime::Cycles64())
+		<< ActorClass.Cycles(Cycles)
+		<< ActorClass.Bytes(Bytes)
+		<< ActorClass.NumActors(NumActors)
+		<< ActorClass.bIsLoading(bIsLoading)
+		<< ActorClass.ClassName(*ClassName, ClassName.Len());
+}
+
+void FSaveGamePhaseStats::TraceCounters() const
+{
+	TRACE_COUNTER_SET(SaveGame_Actors, NumActors);
+	TRACE_COUNTER_SET(SaveGame_SerializedBytes, GetSerializedBytes());
+	TRACE_COUNTER_SET(SaveGame_FileBytes, GetBytes(bIsLoading ? ESaveGamePhase::Read : ESaveGamePhase::Compress));
+}
+
+FSaveGamePhaseScope::FSaveGamePhaseScope(FSaveGamePhaseStats* InStats, ESaveGamePhase InPhase, FArchive* InArchive)
+	: Stats(InStats)
+	, Phase(InPhase)
+	, Archive(InArchive)
+{
+	if (Stats)
+	{
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(SaveGameChannel))
+		{
+			FCpuProfilerTrace::OutputBeginDynamicEvent(*FString::Printf(TEXT("SaveGame_%s"), FSaveGamePhaseStats::GetPhaseName(Phase)));
+			bTraced = true;
+		}
+
+		StartPosition = Archive ? Archive->Tell() : 0;
+		StartAllocations = GetNumAllocations();
+		StartTime = FPlatformTime::Seconds();
+	}
+}
+
+FSaveGamePhaseScope::~FSaveGamePhaseScope()
+{
+	if (Stats)
+	{
+		const int32 PhaseIdx = static_cast<int32>(Phase);
+		const double PhaseSeconds = FPlatformTime::Seconds() - StartTime;
+
+		Stats->Seconds[PhaseIdx] += PhaseSeconds;
+		Stats->Allocations[PhaseIdx] += GetNumAllocations() - StartAllocations;
+		Stats->Bytes[PhaseIdx] += Archive ? Archive->Tell() - StartPosition : Bytes;
+
+#if CSV_PROFILER
+		const FName StatName(FString::Printf(TEXT("%s%s"), Stats->bIsLoading ? TEXT("Load") : TEXT("Save"), FSaveGamePhaseStats::GetPhaseName(Phase)));
+		FCsvProfiler::RecordCustomStat(StatName, CSV_CATEGORY_INDEX(SaveGame), static_cast<float>(PhaseSeconds * 1000.0), ECsvCustomStatOp::Accumulate);
+#endif
+
+		if (bTraced)
+		{
+			FCpuProfilerTrace::OutputEndEvent();
+		}
+	}
+}
+
+int64 FSaveGamePhaseScope::GetNumAllocations()
+{
+#if !UE_BUILD_SHIPPING
+	return static_cast<int64>(FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls);
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,111 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Trace.h"
+
+/** Every buffer that a save or load allocates is tracked under this tag */
+LLM_DECLARE_TAG(SaveGame);
+
+/** Each phase of a save or load, and the time and bytes of each actor class. Enable with -trace=default,SaveGame */
+UE_TRACE_CHANNEL_EXTERN(SaveGameChannel);
+
+/** The duration of each phase, as "SaveActors", "LoadActors", etc */
+CSV_DECLARE_CATEGORY_EXTERN(SaveGame);
+
+/** The phases of a save or load that TSaveGameSerializer measures, in the order they happen */
+enum class ESaveGamePhase : uint8
+{
+	Read,
+	Decompress,
+	Header,
+	Tables,
+	Classes,
+	Actors,
+	DestroyedActors,
+	Levels,
+	Compress,
+	Write,
+
+	Num
+};
+
+/**
+ * What was measured during each phase of a save or load, see TSaveGameSerializer::GetPhaseStats.
+ * Bytes are how much was serialized, read, or written by the phase.
+ */
+struct FSaveGamePhaseStats
+{
+	static constexpr int32 NumPhases = static_cast<int32>(ESaveGamePhase::Num);
+
+	double Seconds[NumPhases] = {};
+	int64 Bytes[NumPhases] = {};
+
+	/**
+	 * The number of allocations made while each phase ran, only counted if the allocator counts them (not in shipping
+	 * builds). This is approximate, as the allocator's counts are global: allocations that other threads made in the
+	 * meantime are included, which matters most for async saves and loads.
+	 */
+	int64 Allocations[NumPhases] = {};
+
+	/** The number of actors that were serialized */
+	int32 NumActors = 0;
+
+	bool bIsLoading = false;
+
+	static const TCHAR* GetPhaseName(ESaveGamePhase Phase);
+
+	double GetSeconds(ESaveGamePhase Phase) const { return Seconds[static_cast<int32>(Phase)]; }
+	int64 GetBytes(ESaveGamePhase Phase) const { return Bytes[static_cast<int32>(Phase)]; }
+
+	/** The time taken by every phase */
+	double GetTotalSeconds() const;
+
+	/** The time taken by the phases that happen on the game thread, even when saving asynchronously */
+	double GetGameThreadSeconds() const;
+
+	/** How many bytes were serialized, which is the size of the save once decompressed */
+	int64 GetSerializedBytes() const;
+
+	FSaveGamePhaseStats& operator+=(const FSaveGamePhaseStats& Other);
+
+	/** Emits an actor class's totals on SaveGameChannel, only called if the channel is enabled */
+	static void TraceActorClass(const UClass* Class, bool bIsLoading, int32 NumActors, uint64 Cycles, uint64 Bytes);
+
+	/** Sets the trace counters from a completed save or load */
+	void TraceCounters() const;
+};
+
+/**
+ * Measures a phase for as long as it's in scope, and emits it as a CPU event on SaveGameChannel and a CSV stat.
+ * Does nothing if there aren't any stats to measure into.
+ */
+class FSaveGamePhaseScope
+{
+public:
+	/** @param InArchive If set, the phase's bytes are however far the archive moved while in scope */
+	FSaveGamePhaseScope(FSaveGamePhaseStats* InStats, ESaveGamePhase InPhase, FArchive* InArchive = nullptr);
+	~FSaveGamePhaseScope();
+
+	/** Sets the phase's bytes, for phases that don't serialize through an archive */
+	void SetBytes(int64 InBytes) { Bytes = InBytes; }
+
+private:
+	FSaveGamePhaseScope(const FSaveGamePhaseScope&) = delete;
+
+	/** The allocator's count of allocations made by every thread, as it doesn't count them per thread */
+	static int64 GetNumAllocations();
+
+	FSaveGamePhaseStats* Stats;
+	ESaveGamePhase Phase;
+	FArchive* Archive;
+
+	double StartTime = 0.0;
+	int64 StartPosition = 0;
+	int64 StartAllocations = 0;
+	int64 Bytes = 0;
+	bool bTraced = false;
+};
@@ -4,4 +4,6 @@
 
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_MODULE(FDefaultGameModuleImpl, SaveGamePlugin)
\ No newline at end of file
+DEFINE_LOG_CATEGORY(LogSaveGame);
+
+IMPLEMENT_MODULE(FDefaultGameModuleImpl, SaveGamePlugin)
@@ -2,11 +2,43 @@
 
 #pragma once
 
+#include "SaveGamePlugin.h"
+#include "Misc/ScopeLock.h"
 #include "Serialization/NameAsStringProxyArchive.h"
 
+/** The name and path tables of a binary save game archive, which serialized names and paths are indices into */
+struct FSaveGameArchiveTables
+{
+	/** The name table, indexed by the serialized name index */
+	TArray<FName> Names;
+
+	/** Only used when saving, to find an existing name's index in the name table */
+	TMap<FName, int32> NameIndices;
+
+	/** The path table, indexed by the serialized path index. When loading, these are already fixed up and redirected. */
+	TArray<FSoftObjectPath> Paths;
+
+	/**
+	 * When saving, used to find an existing path's index in the path table.
+	 * When loading, maps the fixed up path to its index (or indices), so that redirects can be applied.
+	 */
+	TMultiMap<FSoftObjectPath, int32> PathIndices;
+
+	void Reset()
+	{
+		Names.Reset();
+		NameIndices.Reset();
+		Paths.Reset();
+		PathIndices.Reset();
+	}
+};
+
 /**
  * A proxy archive that ensures that all object reference types are stored as a SoftObjectPath.
  * Also has a utility for redirecting those references (used for redirecting spawned actors).
+ *
+ * In binary archives, names and soft object paths are stored as an index into a name or path table, which are
+ * serialized separately with SerializeNameTable and SerializePathTable. Text archives store them inline instead.
  */
 template<bool bIsLoading>
 struct TSaveGameProxyArchive final : public FNameAsStringProxyArchive
@@ -18,17 +50,181 @@ struct TSaveGameProxyArchive final : public FNameAsStringProxyArchive
 		ArIsSaveGame = true;
 	}
 
+	/**
+	 * Creates a proxy archive that adds to another proxy archive's name and path tables, rather than its own.
+	 * Used for saving on worker threads, as access to the shared tables is locked (with a local cache in front).
+	 */
+	TSaveGameProxyArchive(FArchive& InInnerArchive, TSaveGameProxyArchive& InTableOwner)
+		: TSaveGameProxyArchive(InInnerArchive)
+	{
+		check(!bIsLoading);
+		
+		TableOwner = &InTableOwner;
+		SetIsTextFormat(InTableOwner.IsTextFormat());
+	}
+
+	/**
+	 * The archive's name and path tables. When saving, these can be swapped with tables from a previous save, so that
+	 * indices serialized in that save are still valid in this one (only when this archive is the table owner).
+	 */
+	FSaveGameArchiveTables& GetTables()
+	{
+		check(!TableOwner);
+		return Tables;
+	}
+
+	/**
+	 * Whether objects that can't be resolved when loading are loaded synchronously. Turned off when they've already
+	 * been loaded as a batch, so that anything that's still unresolved doesn't cause a blocking load.
+	 */
+	void SetLoadUnresolvedObjects(bool bInLoadUnresolvedObjects)
+	{
+		bLoadUnresolvedObjects = bInLoadUnresolvedObjects;
+	}
+
 	/** Allows the archive to redirect any object (used for redirecting spawned actors). */
 	void AddRedirect(const FSoftObjectPath& From, const FSoftObjectPath& To)
 	{
 		if (From != To)
 		{
 			Redirects.Add(From, To);
+
+			// Each unique path is only redirected once, so patch it directly in the path table
+			TArray<int32, TInlineAllocator<1>> FromIndices;
+			Tables.PathIndices.MultiFind(From, FromIndices);
+
+			for (const int32 PathIndex : FromIndices)
+			{
+				Tables.Paths[PathIndex] = To;
+				ResetResolvedObject(PathIndex);
+			}
 		}
 	}
 
+	/** Serializes each unique name in the archive as a string, which name indices refer to */
+	void SerializeNameTable()
+	{
+		int32 NumNames = Tables.Names.Num();
+		InnerArchive << NumNames;
+
+		if (bIsLoading)
+		{
+			if (NumNames < 0)
+			{
+				SetError();
+				return;
+			}
+			
+			Tables.Names.Reset(NumNames);
+		}
+
+		for (int32 NameIdx = 0; NameIdx < NumNames; ++NameIdx)
+		{
+			FString NameString;
+
+			if (!bIsLoading)
+			{
+				NameString = Tables.Names[NameIdx].ToString();
+			}
+
+			InnerArchive << NameString;
+
+			if (bIsLoading)
+			{
+				// This is the only place that a loaded name is constructed
+				Tables.Names.Add(FName(*NameString));
+			}
+		}
+	}
+
+	/**
+	 * Serializes each unique soft object path in the archive, which path indices refer to.
+	 * When loading, this is where each path is fixed up with CoreRedirects, so must be serialized before AddRedirect.
+	 */
+	void SerializePathTable()
+	{
+		int32 NumPaths = Tables.Paths.Num();
+		InnerArchive << NumPaths;
+
+		if (bIsLoading)
+		{
+			if (NumPaths < 0)
+			{
+				SetError();
+				return;
+			}
+			
+			Tables.Paths.Reset(NumPaths);
+			Tables.PathIndices.Reset();
+			ResolvedObjects.Reset();
+			ResolvedPaths.Reset();
+		}
+
+		for (int32 PathIdx = 0; PathIdx < NumPaths; ++PathIdx)
+		{
+			FSoftObjectPath Path;
+
+			if (!bIsLoading)
+			{
+				Path = Tables.Paths[PathIdx];
+			}
+
+			// Path names are stored in the name table
+			Path.SerializePath(*this);
+
+			if (bIsLoading)
+			{
+				// If we have a defined core redirect, make sure that it's applied
+				if (!Path.IsNull())
+				{
+					Path.FixupCoreRedirects();
+				}
+
+				Tables.PathIndices.Add(Path, PathIdx);
+				Tables.Paths.Add(MoveTemp(Path));
+			}
+		}
+	}
+
+	virtual FArchive& operator<<(FName& Value) override
+	{
+		if (IsTextFormat())
+		{
+			return FNameAsStringProxyArchive::operator<<(Value);
+		}
+
+		int32 NameIndex;
+		
+		if (bIsLoading)
+		{
+			InnerArchive << NameIndex;
+
+			if (Tables.Names.IsValidIndex(NameIndex))
+			{
+				Value = Tables.Names[NameIndex];
+			}
+			else
+			{
+				Value = NAME_None;
+				SetError();
+			}
+		}
+		else
+		{
+			NameIndex = GetNameIndex(Value);
+			InnerArchive << NameIndex;
+		}
+		
+		return *this;
+	}
+
 	virtual FArchive& operator<<(FSoftObjectPath& Value) override
 	{
+		if (!IsTextFormat())
+		{
+			return SerializePathIndex(Value);
+		}
+		
 		Value.SerializePath(*this);
 
 		// If we have a defined core redirect, make sure that it's applied
@@ -37,10 +233,13 @@ struct TSaveGameProxyArchive final : public FNameAsStringProxyArchive
 			Value.FixupCoreRedirects();
 		}
 
-		if (bIsLoading && Redirects.Contains(Value))
+		if (bIsLoading)
 		{
-			// Actually perform the redirect
-			Value = Redirects[Value];
+			if (const FSoftObjectPath* Redirect = Redirects.Find(Value))
+			{
+				// Actually perform the redirect
+				Value = *Redirect;
+			}
 		}
 		
 		return *this;
@@ -83,6 +282,113 @@ struct TSaveGameProxyArchive final : public FNameAsStringProxyArchive
 private:
 	TMap<FSoftObjectPath, FSoftObjectPath> Redirects;
 
+	/** The name and path tables, or a local cache of them if we have a TableOwner */
+	FSaveGameArchiveTables Tables;
+
+	/** If set, names and paths are added to this archive's tables instead, and our tables are just a local cache */
+	TSaveGameProxyArchive* TableOwner = nullptr;
+
+	/** Locks our tables when they're shared with other archives */
+	FCriticalSection TableLock;
+
+	/**
+	 * When loading a binary archive, the object that each path in the path table resolved to, so that each unique path
+	 * is only resolved (or loaded) once, no matter how many times it's referenced.
+	 */
+	TArray<FWeakObjectPtr> ResolvedObjects;
+
+	/** Whether each path in the path table has been resolved, even if it resolved to nothing */
+	TBitArray<> ResolvedPaths;
+
+	bool bLoadUnresolvedObjects = true;
+
+	FArchive& SerializePathIndex(FSoftObjectPath& Value)
+	{
+		int32 PathIndex;
+
+		if (bIsLoading)
+		{
+			InnerArchive << PathIndex;
+
+			if (Tables.Paths.IsValidIndex(PathIndex))
+			{
+				Value = Tables.Paths[PathIndex];
+			}
+			else
+			{
+				Value.Reset();
+
+				// Null paths aren't stored in the table
+				if (PathIndex != INDEX_NONE)
+				{
+					SetError();
+				}
+			}
+		}
+		else
+		{
+			if (Value.IsNull())
+			{
+				PathIndex = INDEX_NONE;
+			}
+			else
+			{
+				PathIndex = GetPathIndex(Value);
+			}
+
+			InnerArchive << PathIndex;
+		}
+
+		return *this;
+	}
+
+	int32 GetNameIndex(const FName Name)
+	{
+		if (const int32* ExistingIndex = Tables.NameIndices.Find(Name))
+		{
+			return *ExistingIndex;
+		}
+
+		int32 NameIndex;
+		
+		if (TableOwner)
+		{
+			FScopeLock Lock(&TableOwner->TableLock);
+			NameIndex = TableOwner->GetNameIndex(Name);
+		}
+		else
+		{
+			// Note: names compare without case, so the first casing of a name is the one that's stored
+			NameIndex = Tables.Names.Add(Name);
+		}
+
+		Tables.NameIndices.Add(Name, NameIndex);
+		return NameIndex;
+	}
+
+	int32 GetPathIndex(const FSoftObjectPath& Path)
+	{
+		if (const int32* ExistingIndex = Tables.PathIndices.Find(Path))
+		{
+			return *ExistingIndex;
+		}
+
+		int32 PathIndex;
+
+		if (TableOwner)
+		{
+			FScopeLock Lock(&TableOwner->TableLock);
+			PathIndex = TableOwner->GetPathIndex(Path);
+		}
+		else
+		{
+			PathIndex = Tables.Paths.Add(Path);
+		}
+		
+		Tables.PathIndices.Add(Path, PathIndex);
+		return PathIndex;
+	}
+
 	template<typename ObjectType>
 	static FSoftObjectPath ToSoftObjectPath(const ObjectType& Value)
 	{
@@ -93,9 +399,78 @@ private:
 		return FSoftObjectPath(Value.Get());
 	}
 
+	UObject* ResolvePathIndex(const int32 PathIndex)
+	{
+		if (!Tables.Paths.IsValidIndex(PathIndex))
+		{
+			// Null paths aren't stored in the table
+			if (PathIndex != INDEX_NONE)
+			{
+				SetError();
+			}
+
+			return nullptr;
+		}
+
+		if (ResolvedPaths.Num() <= PathIndex)
+		{
+			ResolvedObjects.SetNum(Tables.Paths.Num());
+			ResolvedPaths.SetNum(Tables.Paths.Num(), false);
+		}
+
+		FWeakObjectPtr& ResolvedObject = ResolvedObjects[PathIndex];
+
+		// Resolve again if the object we resolved to has since been destroyed
+		if (!ResolvedPaths[PathIndex] || ResolvedObject.IsStale())
+		{
+			ResolvedObject = ResolveObject(Tables.Paths[PathIndex]);
+			ResolvedPaths[PathIndex] = true;
+		}
+
+		return ResolvedObject.Get();
+	}
+
+	void ResetResolvedObject(const int32 PathIndex)
+	{
+		if (ResolvedPaths.IsValidIndex(PathIndex))
+		{
+			ResolvedObjects[PathIndex].Reset();
+			ResolvedPaths[PathIndex] = false;
+		}
+	}
+
+	UObject* ResolveObject(const FSoftObjectPath& Path) const
+	{
+		UObject* Object = Path.ResolveObject();
+
+		if (!IsValid(Object) && !Path.IsNull())
+		{
+			if (bLoadUnresolvedObjects)
+			{
+				Object = Path.TryLoad();
+			}
+			else
+			{
+				UE_LOG(LogSaveGame, Verbose, TEXT("Couldn't resolve '%s', as it wasn't loaded with the save's batch"), *Path.ToString());
+			}
+		}
+
+		return Object;
+	}
+
 	template<typename ObjectType>
 	FArchive& SerializeObject(ObjectType& Value)
 	{
+		if (bIsLoading && !IsTextFormat())
+		{
+			// Repeated references to the same path reuse the object it first resolved to
+			int32 PathIndex;
+			InnerArchive << PathIndex;
+			
+			Value = ResolvePathIndex(PathIndex);
+			return *this;
+		}
+		
 		FSoftObjectPath Path;
 
 		if (!bIsLoading)
@@ -107,13 +482,7 @@ private:
 
 		if (bIsLoading)
 		{
-			UObject* Object = Path.ResolveObject();
-			Value = Object;
-
-			if (!IsValid(Object) && !Path.IsNull())
-			{
-				Value = Path.TryLoad();
-			}
+			Value = ResolveObject(Path);
 		}
 
 		return *this;
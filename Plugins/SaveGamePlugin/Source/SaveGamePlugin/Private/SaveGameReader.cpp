@@ -0,0 +1,46 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameReader.h"
+
+#include "SaveGameSerializer.h"
+
+FSaveGameReader::FSaveGameReader()
+	: Serializer(MakePimpl<TSaveGameSerializer<true, false>>(nullptr))
+	, bIsOpen(false)
+{
+}
+
+FSaveGameReader::~FSaveGameReader() = default;
+
+bool FSaveGameReader::Open(const FString& SaveName)
+{
+	check(!bIsOpen);
+	
+	bIsOpen = Serializer->OpenForRead(SaveName);
+	return bIsOpen;
+}
+
+const FString& FSaveGameReader::GetMapName() const
+{
+	return Serializer->GetMapName();
+}
+
+bool FSaveGameReader::ContainsActor(const FName ActorName) const
+{
+	return bIsOpen && Serializer->FindActor(ActorName) != INDEX_NONE;
+}
+
+bool FSaveGameReader::ContainsActor(const FGuid& SpawnID) const
+{
+	return bIsOpen && Serializer->FindActor(SpawnID) != INDEX_NONE;
+}
+
+bool FSaveGameReader::ReadActor(const FName ActorName, TFunctionRef<void(FSaveGameArchive&)> ReadFunction, UObject* PropertiesTarget)
+{
+	return bIsOpen && Serializer->ReadActor(Serializer->FindActor(ActorName), PropertiesTarget, ReadFunction);
+}
+
+bool FSaveGameReader::ReadActor(const FGuid& SpawnID, TFunctionRef<void(FSaveGameArchive&)> ReadFunction, UObject* PropertiesTarget)
+{
+	return bIsOpen && Serializer->ReadActor(Serializer->FindActor(SpawnID), PropertiesTarget, ReadFunction);
+}
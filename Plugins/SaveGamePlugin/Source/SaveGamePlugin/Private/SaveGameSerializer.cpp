@@ -4,41 +4,49 @@
 
 #include "SaveGameSerializer.h"
 
+#include "SaveGameActorRegistry.h"
+#include "SaveGameCompression.h"
+#include "SaveGameFileHeader.h"
 #include "SaveGameFunctionLibrary.h"
+#include "SaveGameIncrementalCache.h"
 #include "SaveGameObject.h"
+#include "SaveGamePhaseStats.h"
+#include "SaveGameSizeProfile.h"
 #include "SaveGameSubsystem.h"
 #include "SaveGameVersion.h"
 
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Algo/Sort.h"
+#include "Engine/AssetManager.h"
+#include "HAL/FileManager.h"
 #include "SaveGameSystem.h"
 #include "PlatformFeatures.h"
 
 #define LEVEL_SUBPATH_PREFIX TEXT("PersistentLevel.")
 
-template<bool bLoading>
-FORCEINLINE_DEBUGGABLE void SerializeCompressedData(FArchive& Ar, TArray<uint8>& Data)
-{
-	check(Ar.IsLoading() == bLoading);
-	
-	int64 UncompressedSize;
-
-	if (!bLoading)
-	{
-		UncompressedSize = Data.Num();
-	}
+// The minimum number of actors to give each worker when serializing actors in parallel
+#define MIN_PARALLEL_ACTORS_PER_WRITER 32
 
-	Ar << UncompressedSize;
-	
-	if (bLoading)
+/** Whether a class has opted in to having its actors serialized on worker threads */
+static bool CanSerializeOnAnyThread(const UClass* Class)
+{
+	// Blueprint implementations of OnSerialize can only run on the game thread
+	const UFunction* OnSerializeFunction = Class->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(ISaveGameObject, OnSerialize));
+	if (!OnSerializeFunction || !OnSerializeFunction->HasAnyFunctionFlags(FUNC_Native))
 	{
-		Data.SetNumUninitialized(UncompressedSize);
+		return false;
 	}
 
-	Ar.SerializeCompressed(Data.GetData(), UncompressedSize, NAME_Zlib);
+	const ISaveGameObject* SaveGameObject = Cast<ISaveGameObject>(Class->GetDefaultObject());
+	return SaveGameObject && SaveGameObject->CanSerializeOnAnyThread();
 }
 
 template <bool bIsLoading, bool bIsTextFormat>
-TSaveGameSerializer<bIsLoading, bIsTextFormat>::TSaveGameSerializer(USaveGameSubsystem* InSaveGameSubsystem)
+TSaveGameSerializer<bIsLoading, bIsTextFormat>::TSaveGameSerializer(USaveGameSubsystem* InSaveGameSubsystem, ULevel* InLevel)
 	: SaveGameSubsystem(InSaveGameSubsystem)
+	, Level(InLevel)
 	, Archive(Data)
 	, ProxyArchive(Archive)
 	, Formatter(ProxyArchive)
@@ -46,17 +54,47 @@ TSaveGameSerializer<bIsLoading, bIsTextFormat>::TSaveGameSerializer(USaveGameSub
 	, RootSlot(StructuredArchive.Open())
 	, RootRecord(RootSlot.EnterRecord())
 	, VersionOffset(0)
+	, PathsOffset(0)
+	, NamesOffset(0)
+	, IndexOffset(0)
+	, SaveName(GetSaveName())
+	, SaveSystem(nullptr)
+	, CompressedDataOffset(0)
+	, CompressionBlockSize(0)
+	, bStreamSucceeded(false)
+	, LoadStreamingBlocks(0)
+	, bBatchLoadReferences(false)
+	, bBatchLoadingReferences(false)
+	, bDataReady(false)
+	, bLoadCancelled(false)
 {
 	static_cast<FArchive&>(ProxyArchive).SetIsTextFormat(bIsTextFormat);
 
 	// Ensure that we're using the latest save game version
 	Archive.UsingCustomVersion(FSaveGameVersion::GUID);
+
+	PhaseStats.bIsLoading = bIsLoading;
+
+	// Grab these now, as settings shouldn't be accessed off the game thread
+	if (bIsLoading && GetDefault<USaveGameSettings>()->ShouldStreamLoads())
+	{
+		LoadStreamingBlocks = GetDefault<USaveGameSettings>()->GetLoadStreamingBlocks();
+	}
+
+	bBatchLoadReferences = bIsLoading && GetDefault<USaveGameSettings>()->ShouldBatchLoadReferences();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+ULevel* TSaveGameSerializer<bIsLoading, bIsTextFormat>::GetLevel() const
+{
+	return Level ? Level : SaveGameSubsystem->GetWorld()->PersistentLevel.Get();
 }
 
 template <bool bIsLoading, bool bIsTextFormat>
-bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::Save()
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::Save(ESaveGameType SaveType)
 {
 	check(!bIsLoading);
+	LLM_SCOPE_BYTAG(SaveGame);
 
 	TRACE_BOOKMARK(TEXT("Begin: SaveGame[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
 
@@ -65,124 +103,1540 @@ bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::Save()
 		TRACE_BOOKMARK(TEXT("End: SaveGame[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
 	};
 	
-	if (ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem())
+	if (!SerializeSave(SaveType))
 	{
-		SerializeHeader();
-		SerializeActors();
-		SerializeDestroyedActors();
+		return false;
+	}
+
+	CompressData();
+
+	const bool bSuccess = WriteData();
+	ReportStats(bSuccess);
+	return bSuccess;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+UE::Tasks::FTask TSaveGameSerializer<bIsLoading, bIsTextFormat>::SaveAsync(ESaveGameType SaveType, const UE::Tasks::FTask& PreviousSave, TUniqueFunction<void(bool)>&& OnCompleted)
+{
+	check(!bIsLoading && IsInGameThread());
+	LLM_SCOPE_BYTAG(SaveGame);
+
+	TRACE_BOOKMARK(TEXT("Begin: SaveGameAsync[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
+	
+	// Keep ourselves alive until our worker tasks are complete
+	const TSharedRef<TSaveGameSerializer> This = StaticCastSharedRef<TSaveGameSerializer>(AsShared());
 
-		if (!bIsTextFormat)
+	TArray<UE::Tasks::FTask> WritePrerequisites;
+	
+	// Only the actor serialization needs to happen on the game thread
+	if (SerializeSave(SaveType))
+	{
+		WritePrerequisites.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [This]
 		{
-			// Store the version position so that we can serialize it in the header
-			VersionOffset = Archive.Tell();
-		}
-		
-		SerializeVersions();
+			LLM_SCOPE_BYTAG(SaveGame);
+			This->CompressData();
+		}));
+	}
+	else
+	{
+		// Nothing to compress or write, just report the failure
+		SaveSystem = nullptr;
+	}
 
-		if (!bIsTextFormat)
+	// Saves write to the same file, so make sure that they land in the order they were made
+	if (PreviousSave.IsValid())
+	{
+		WritePrerequisites.Add(PreviousSave);
+	}
+
+	if (!FSaveGameFileHeader::AreSlotsFiles())
+	{
+		// The platform's save game system can only be used from the game thread, so the subsystem writes us from
+		// there once we've been compressed, in the order that its saves were made
+		OnAsyncSaveCompleted = MoveTemp(OnCompleted);
+		
+		return UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakSubsystem = SaveGameSubsystem]
 		{
-			// We've updated the VersionOffset, let's go back to the start and rewrite the header
-			Archive.Seek(0);
-			SerializeHeader();
-		}
+			AsyncTask(ENamedThreads::GameThread, [WeakSubsystem]
+			{
+				if (USaveGameSubsystem* Subsystem = WeakSubsystem.Get())
+				{
+					Subsystem->WritePendingSaves();
+				}
+			});
+		}, WritePrerequisites);
+	}
 
-		// Be sure to close this, as you'll be missing closed braces for JSON archives
-		StructuredArchive.Close();
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [This, OnCompleted = MoveTemp(OnCompleted)]() mutable
+	{
+		LLM_SCOPE_BYTAG(SaveGame);
+		const bool bSuccess = This->SaveSystem && This->WriteData();
 		
-		if (!bIsTextFormat && !bIsLoading)
+		TRACE_BOOKMARK(TEXT("End: SaveGameAsync[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
+
+		AsyncTask(ENamedThreads::GameThread, [This, OnCompleted = MoveTemp(OnCompleted), bSuccess]
 		{
-			// Compress the save game data
-			TArray<uint8> CompressedData;
-			FSaveGameMemoryArchive CompressorArchive(CompressedData);
-			SerializeCompressedData<false>(CompressorArchive, Data);
+			This->ReportStats(bSuccess);
+			OnCompleted(bSuccess);
+		});
+	}, WritePrerequisites);
+}
 
-			return SaveSystem->SaveGame(false, *GetSaveName(), 0, CompressedData);
-		}
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::WriteAsyncSave()
+{
+	check(!bIsLoading && IsInGameThread());
+	LLM_SCOPE_BYTAG(SaveGame);
+
+	const bool bSuccess = SaveSystem && WriteData();
+
+	TRACE_BOOKMARK(TEXT("End: SaveGameAsync[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
+
+	ReportStats(bSuccess);
+
+	if (OnAsyncSaveCompleted)
+	{
+		// Moved out first, as saving again from the callback would otherwise replace it while it's being called
+		const TUniqueFunction<void(bool)> OnCompleted = MoveTemp(OnAsyncSaveCompleted);
+		OnCompleted(bSuccess);
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::BeginIncrementalSave()
+{
+	check(!bIsLoading && !bIsTextFormat);
+
+	const USaveGameSettings* Settings = GetDefault<USaveGameSettings>();
+	FSaveGameIncrementalCache& Cache = *SaveGameSubsystem->IncrementalCache;
+
+	// Nothing invalidates the cache while incremental saves are disabled, so it can't be trusted afterwards
+	if (!Settings->UseIncrementalSaves() || Cache.NumSaves >= Settings->GetIncrementalSaveFlushInterval())
+	{
+		Cache.Reset();
+	}
+
+	if (!Settings->UseIncrementalSaves())
+	{
+		return;
+	}
+
+	IncrementalCache = SaveGameSubsystem->IncrementalCache;
+
+	// Cached actor data indexes into the previous save's tables, so we carry on from those
+	Swap(ProxyArchive.GetTables(), IncrementalCache->Tables);
+
+	for (const FCustomVersion& CustomVersion : IncrementalCache->Versions.GetAllVersions())
+	{
+		Archive.SetCustomVersion(CustomVersion.Key, CustomVersion.Version, CustomVersion.GetFriendlyName());
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeSave(ESaveGameType SaveType)
+{
+	check(!bIsLoading);
+
+	// Grab these now, as settings shouldn't be accessed off the game thread
+	CompressionSettings = GetDefault<USaveGameSettings>()->GetCompressionSettings(SaveType);
+	CompressionBlockSize = GetDefault<USaveGameSettings>()->GetCompressionBlockSize();
+	
+	SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || !SaveGameSubsystem.IsValid())
+	{
+		return false;
+	}
+
+	if (!bIsTextFormat)
+	{
+		// The header is written before the rest of the save (or while it's compressed), so the slot's metadata is
+		// gathered up front
+		MapName = GetWorldMapName(SaveGameSubsystem->GetWorld());
+		
+		FileHeader = FSaveGameFileHeader(MapName);
+		FileHeader.Codec = CompressionSettings.Codec;
+		FileHeader.BlockSize = CompressionBlockSize;
+		FileHeader.Timestamp = FDateTime::UtcNow();
+		FileHeader.PlaySeconds = SaveGameSubsystem->GetPlaySeconds();
+		FileHeader.UserData = SaveGameSubsystem->SlotUserData;
 		
-		return SaveSystem->SaveGame(false, *GetSaveName(), 0, Data);
+		BeginIncrementalSave();
+		BeginStreaming();
 	}
 
-	return false;
+	GatherActors();
+	SerializeArchive();
+
+	if (BlockWriter)
+	{
+		// Hand off the rest of the data, the last blocks are compressed and written with the file header by CompressData
+		GetStreamWriter().EndStreaming();
+	}
+
+	return true;
 }
 
 template <bool bIsLoading, bool bIsTextFormat>
-bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::Load()
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::BeginStreaming()
 {
-	check(bIsLoading && !bIsTextFormat);
+	check(!bIsLoading && !bIsTextFormat);
 
-	TRACE_BOOKMARK(TEXT("Begin: LoadSaveGame[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
+	// Streamed saves are written straight to the slot's file, bypassing the platform's save game system
+	const USaveGameSettings* Settings = GetDefault<USaveGameSettings>();
+	if (!Settings->ShouldStreamSaves() || !FSaveGameFileHeader::AreSlotsFiles())
+	{
+		return;
+	}
+
+	// Write to a temporary file until we're done, so that a failed save doesn't replace the previous one
+	StreamFilename = FPaths::CreateTempFilename(*FPaths::GetPath(GetSaveFilename()), *SaveName, TEXT(".tmp"));
+
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*StreamFilename));
+	if (!File)
+	{
+		UE_LOG(LogSaveGame, Warning, TEXT("Couldn't open '%s' to stream the save to, the save won't be streamed"), *StreamFilename);
+		StreamFilename.Reset();
+		return;
+	}
+
+	// The file header is written first, it's rewritten with the block table's offset once every block is written
+	*File << FileHeader;
+
+	BlockWriter = MakeUnique<FSaveGameBlockWriter>(MoveTemp(File), CompressionSettings, Settings->GetMaxStreamingBlocks());
+
+	GetStreamWriter().BeginStreaming(CompressionBlockSize, [this](TConstArrayView<uint8> Block)
+	{
+		BlockWriter->AddBlock(Block);
+	});
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+FSaveGameStreamWriter& TSaveGameSerializer<bIsLoading, bIsTextFormat>::GetStreamWriter()
+{
+	check(!bIsLoading);
+	return static_cast<FSaveGameStreamWriter&>(static_cast<FArchive&>(Archive));
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+FSaveGameStreamReader& TSaveGameSerializer<bIsLoading, bIsTextFormat>::GetStreamReader()
+{
+	check(bIsLoading);
+	return static_cast<FSaveGameStreamReader&>(static_cast<FArchive&>(Archive));
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+FString TSaveGameSerializer<bIsLoading, bIsTextFormat>::GetSaveFilename() const
+{
+	return FSaveGameFileHeader::GetSlotFilename(SaveName);
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::SaveLevel(TArray<AActor*>&& InLevelActors, TArray<FSoftObjectPath>&& InDestroyedActors, TArray<uint8>& OutData)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SaveLevel);
+	LLM_SCOPE_BYTAG(SaveGame);
+	
+	check(!bIsLoading && !bIsTextFormat && Level);
+	
+	if (!SaveGameSubsystem.IsValid())
+	{
+		return false;
+	}
+
+	MapName = Level->GetPackage()->GetName();
+	LevelActors = MoveTemp(InLevelActors);
+	LevelDestroyedActors = MoveTemp(InDestroyedActors);
+
+	SerializeArchive();
+
+	OutData = MoveTemp(Data);
+	return true;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::LoadLevelAsync(TArray<uint8>&& LevelData, TUniqueFunction<void(bool)>&& OnCompleted)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_LoadLevel);
+	LLM_SCOPE_BYTAG(SaveGame);
+	
+	check(bIsLoading && !bIsTextFormat && Level && IsInGameThread());
+
+	// Our archive reads from Data, so it'll pick up the level's data
+	Data = MoveTemp(LevelData);
+	
+	if (!SaveGameSubsystem.IsValid() || !ReadTables())
+	{
+		OnCompleted(false);
+		return;
+	}
+
+	GatherClasses();
+	GatherReferences();
+
+	// Set first, as the request may complete straight away if everything is already loaded
+	OnLevelLoaded = MoveTemp(OnCompleted);
+	RequestClasses(FStreamableDelegate::CreateThreadSafeSP(this, &TSaveGameSerializer::FinishLoadLevel));
+
+	if (!ClassesHandle.IsValid() || ClassesHandle->HasLoadCompleted())
+	{
+		FinishLoadLevel();
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::FinishLoadLevel()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_LoadLevel);
+	LLM_SCOPE_BYTAG(SaveGame);
+
+	// Already finished, or cancelled
+	if (!OnLevelLoaded)
+	{
+		return;
+	}
+
+	const TUniqueFunction<void(bool)> OnCompleted = MoveTemp(OnLevelLoaded);
+
+	if (!SaveGameSubsystem.IsValid())
+	{
+		OnCompleted(false);
+		return;
+	}
+
+	// The classes have already loaded, this only finishes up with them
+	WaitForClasses();
+
+	SerializeActors();
+	SerializeDestroyedActors();
+
+	OnCompleted(!Archive.IsError());
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+TArray<uint8> TSaveGameSerializer<bIsLoading, bIsTextFormat>::CancelLoadLevel()
+{
+	OnLevelLoaded.Reset();
+
+	if (ClassesHandle.IsValid())
+	{
+		ClassesHandle->CancelHandle();
+		ClassesHandle.Reset();
+	}
+
+	return MoveTemp(Data);
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeArchive()
+{
+	check(!bIsLoading);
 	
-	TArray<uint8> CompressedData;
-	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
-	if (SaveSystem && SaveSystem->LoadGame(false, *GetSaveName(), 0, CompressedData))
+	SerializeHeader();
+	SerializeActors();
+	SerializeDestroyedActors();
+	SerializeLevels();
+
+	if (!bIsTextFormat)
 	{
-		// Decompress the loaded save game data
-		FSaveGameMemoryArchive CompressorArchive(CompressedData);
-		SerializeCompressedData<true>(CompressorArchive, Data);
+		IndexOffset = Archive.Tell();
+		SerializeIndex();
 		
-		SerializeHeader();
+		// Store the version position so that we can serialize it in the footer
+		VersionOffset = Archive.Tell();
+	}
+	
+	SerializeVersions();
+
+	if (!bIsTextFormat)
+	{
+		PathsOffset = Archive.Tell();
+		SerializePaths();
 		
+		// Names are written last, as anything before this point (including paths) may have added to the name table
+		NamesOffset = Archive.Tell();
+		SerializeNames();
+
+		if (IncrementalCache)
 		{
-			const uint64 InitialPosition = Archive.Tell();
+			// Hand the tables back, so that the next save can index into them too
+			IncrementalCache->Tables = MoveTemp(ProxyArchive.GetTables());
+			IncrementalCache->Versions = Archive.GetCustomVersions();
+			++IncrementalCache->NumSaves;
+		}
+		
+		SerializeFooter();
+	}
 
-			// After serializing versions, go back to initial position
-			ON_SCOPE_EXIT
-			{
-				Archive.Seek(InitialPosition);
-			};
+	// Be sure to close this, as you'll be missing closed braces for JSON archives
+	StructuredArchive.Close();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::GatherActors()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_GatherActors);
+	
+	check(!bIsLoading && !Level);
 
-			Archive.Seek(VersionOffset);
-			SerializeVersions();
+	const UWorld* World = SaveGameSubsystem->GetWorld();
+	const ULevel* PersistentLevel = World->PersistentLevel;
+	const FName PersistentLevelName = USaveGameSubsystem::GetLevelChunkName(PersistentLevel->GetPackage()->GetName());
+
+	// Text archives aren't split into levels, everything goes in the one list of actors
+	const bool bSplitLevels = !bIsTextFormat;
+	
+	TMap<const ULevel*, TArray<AActor*>> StreamingLevelActors;
+	TMap<FName, TArray<FSoftObjectPath>> StreamingLevelDestroyedActors;
+
+	for (const TWeakObjectPtr<AActor>& ActorPtr : SaveGameSubsystem->ActorRegistry->GetActors())
+	{
+		AActor* Actor = ActorPtr.Get();
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+		
+		const ULevel* ActorLevel = Actor->GetLevel();
+		if (!bSplitLevels || ActorLevel == PersistentLevel)
+		{
+			LevelActors.Add(Actor);
+		}
+		else
+		{
+			StreamingLevelActors.FindOrAdd(ActorLevel).Add(Actor);
 		}
+	}
 
-		// If we don't have a map, we should bail
-		if (MapName.IsEmpty())
+	for (const FSoftObjectPath& DestroyedActor : SaveGameSubsystem->DestroyedLevelActors)
+	{
+		const FName LevelName = USaveGameSubsystem::GetLevelChunkName(DestroyedActor.GetLongPackageName());
+		if (!bSplitLevels || LevelName == PersistentLevelName)
 		{
-			return false;
+			LevelDestroyedActors.Add(DestroyedActor);
+		}
+		else
+		{
+			StreamingLevelDestroyedActors.FindOrAdd(LevelName).Add(DestroyedActor);
 		}
+	}
 
-		check(SaveGameSubsystem.IsValid());
-		UWorld* World = SaveGameSubsystem->GetWorld();
+	if (!bSplitLevels)
+	{
+		return;
+	}
+
+	// Each loaded streaming level is saved as a chunk of its own, unloaded levels already have theirs
+	for (ULevel* StreamingLevel : World->GetLevels())
+	{
+		if (StreamingLevel == PersistentLevel || !StreamingLevel->bIsVisible)
+		{
+			continue;
+		}
+
+		const FName LevelName = USaveGameSubsystem::GetLevelChunkName(StreamingLevel->GetPackage()->GetName());
 
-		if (World->IsInSeamlessTravel())
+		if (const TSharedPtr<FSaveGameSerializer, ESPMode::ThreadSafe>* PendingChunk = SaveGameSubsystem->PendingLevelChunks.Find(LevelName))
 		{
-			return false;
+			// The level's chunk is still waiting on its classes, so its actors don't have their saved state yet
+			LevelChunks.Add(LevelName, StaticCastSharedPtr<TSaveGameSerializer<true>>(*PendingChunk)->GetLevelData());
+			continue;
 		}
+		
+		TArray<AActor*> Actors;
+		StreamingLevelActors.RemoveAndCopyValue(StreamingLevel, Actors);
 
-		// When our map has loaded, call the OnMapLoad method
-		FCoreUObjectDelegates::PostLoadMapWithWorld.AddThreadSafeSP(this, &TSaveGameSerializer::OnMapLoad);
-		World->SeamlessTravel(MapName, true);
+		TArray<FSoftObjectPath> DestroyedActors;
+		StreamingLevelDestroyedActors.RemoveAndCopyValue(LevelName, DestroyedActors);
 
-		return true;
+		TSaveGameSerializer<false> LevelSerializer(SaveGameSubsystem.Get(), StreamingLevel);
+		LevelSerializer.SaveLevel(MoveTemp(Actors), MoveTemp(DestroyedActors), LevelChunks.Add(LevelName));
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::CompressData()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_CompressData);
+	FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Compress);
+	
+	if (BlockWriter)
+	{
+		BlockWriter->Flush();
+
+		// Now that every block has been written, the block table and the header's final values can be written
+		FArchive& File = BlockWriter->GetFile();
+		FileHeader.UncompressedSize = GetStreamWriter().GetStreamedSize();
+		FileHeader.BlockSizes = BlockWriter->GetBlockSizes();
+		FileHeader.BlockTableOffset = File.Tell();
+		FileHeader.SerializeBlockTable(File);
+
+		File.Seek(0);
+		File << FileHeader;
+
+		PhaseScope.SetBytes(File.TotalSize());
+
+		bStreamSucceeded = File.Close() && !GetStreamWriter().IsError();
+		BlockWriter.Reset();
 	}
+	else if (!bIsTextFormat && !bIsLoading)
+	{
+		// SerializeSave has already filled in the rest of the header
+		FileHeader.UncompressedSize = Data.Num();
+		
+		// Compress the save game data, the file header needs each block's compressed size
+		TArray<uint8> CompressedBlocks;
+		FSaveGameCompression::CompressBlocks(CompressionSettings, FileHeader.BlockSize, Data, FileHeader.BlockSizes, CompressedBlocks);
+		
+		// Write the uncompressed header first, so that loading can start travelling before decompressing
+		FMemoryWriter CompressorArchive(CompressedData);
+		CompressorArchive << FileHeader;
+		
+		CompressedData.Append(CompressedBlocks);
 
-	return false;
+		// The block table follows the blocks, same as a streamed save
+		FileHeader.BlockTableOffset = CompressorArchive.Tell() + CompressedBlocks.Num();
+		CompressorArchive.Seek(FileHeader.BlockTableOffset);
+		FileHeader.SerializeBlockTable(CompressorArchive);
+
+		CompressorArchive.Seek(0);
+		CompressorArchive << FileHeader;
+
+		PhaseScope.SetBytes(CompressedData.Num());
+	}
 }
 
 template <bool bIsLoading, bool bIsTextFormat>
-FString TSaveGameSerializer<bIsLoading, bIsTextFormat>::GetSaveName()
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::WriteData()
 {
-	FString SaveName = TEXT("SaveGame");
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WriteData);
+	FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Write);
+	
+	check(SaveSystem);
 
-	if (bIsTextFormat)
+	if (!StreamFilename.IsEmpty())
 	{
-		SaveName += TEXT(".json");
+		IFileManager& FileManager = IFileManager::Get();
+
+		if (!bStreamSucceeded || !FileManager.Move(*GetSaveFilename(), *StreamFilename))
+		{
+			FileManager.Delete(*StreamFilename);
+			return false;
+		}
+
+		return true;
+	}
+	
+	const TArray<uint8>& FileData = bIsTextFormat ? Data : CompressedData;
+	PhaseScope.SetBytes(FileData.Num());
+	
+	return SaveSystem->SaveGame(false, *SaveName, 0, FileData);
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::Load()
+{
+	check(bIsLoading && !bIsTextFormat);
+	LLM_SCOPE_BYTAG(SaveGame);
+
+	TRACE_BOOKMARK(TEXT("Begin: LoadSaveGame[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
+	
+	SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	FString SaveMapName;
+	if (SaveSystem && ReadSave(SaveMapName))
+	{
+		bDataReady = DecompressData();
+
+		if (bDataReady)
+		{
+			// Load classes (and referenced assets) in the background while we travel
+			GatherClasses();
+			GatherReferences();
+			RequestClasses();
+		}
+		
+		return bDataReady && Travel(SaveMapName);
+	}
+
+	return false;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::LoadAsync()
+{
+	check(bIsLoading && !bIsTextFormat && IsInGameThread());
+	LLM_SCOPE_BYTAG(SaveGame);
+
+	TRACE_BOOKMARK(TEXT("Begin: LoadSaveGameAsync[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
+	
+	SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem || !SaveSystem->DoesSaveGameExist(*SaveName, 0))
+	{
+		return false;
+	}
+
+	check(SaveGameSubsystem.IsValid());
+	if (SaveGameSubsystem->GetWorld()->IsInSeamlessTravel())
+	{
+		return false;
+	}
+
+	// Keep ourselves alive until our worker task is complete
+	const TSharedRef<TSaveGameSerializer> This = StaticCastSharedRef<TSaveGameSerializer>(AsShared());
+
+	if (FSaveGameFileHeader::AreSlotsFiles())
+	{
+		LoadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [This]
+		{
+			LLM_SCOPE_BYTAG(SaveGame);
+
+			FString SaveMapName;
+			const bool bReadSave = This->ReadSave(SaveMapName);
+			This->LoadAsyncData(bReadSave, SaveMapName);
+		});
+
+		return true;
+	}
+
+	// The platform's save game system can only be used from the game thread, but it can read the save in the
+	// background. Its callback is on the game thread, so the rest is handed off to a worker from there.
+	const double ReadStartTime = FPlatformTime::Seconds();
+	
+	SaveSystem->LoadGameAsync(false, *SaveName, FPlatformMisc::GetPlatformUserForUserIndex(0), [This, ReadStartTime](const FString&, FPlatformUserId, bool bSuccess, const TArray<uint8>& FileData)
+	{
+		This->PhaseStats.Seconds[static_cast<int32>(ESaveGamePhase::Read)] = FPlatformTime::Seconds() - ReadStartTime;
+		This->PhaseStats.Bytes[static_cast<int32>(ESaveGamePhase::Read)] = FileData.Num();
+		This->CompressedData = FileData;
+
+		This->LoadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [This, bSuccess]
+		{
+			LLM_SCOPE_BYTAG(SaveGame);
+
+			FString SaveMapName;
+			const bool bReadSave = bSuccess && This->ReadFileHeader(SaveMapName);
+			This->LoadAsyncData(bReadSave, SaveMapName);
+		});
+	});
+
+	return true;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::LoadAsyncData(bool bReadSave, const FString& SaveMapName)
+{
+	// Keep ourselves alive until the game thread is done with us
+	const TSharedRef<TSaveGameSerializer> This = StaticCastSharedRef<TSaveGameSerializer>(AsShared());
+
+	// Start travelling as soon as we know where to go, decompression will continue while the map loads
+	AsyncTask(ENamedThreads::GameThread, [This, bReadSave, SaveMapName]
+	{
+		if (!bReadSave || !This->Travel(SaveMapName))
+		{
+			This->CancelLoad();
+		}
+	});
+
+	if (!bReadSave)
+	{
+		return;
+	}
+
+	// Travel may have already failed, in which case nothing will use the data
+	bDataReady = !bLoadCancelled && DecompressData();
+	if (!bDataReady || bLoadCancelled)
+	{
+		return;
+	}
+
+	GatherClasses();
+	GatherReferences();
+
+	// Streamable requests can only be made on the game thread
+	AsyncTask(ENamedThreads::GameThread, [This]
+	{
+		if (!This->bLoadCancelled)
+		{
+			This->RequestClasses();
+		}
+	});
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::LoadWithoutTravel()
+{
+	check(bIsLoading && !bIsTextFormat && SaveGameSubsystem.IsValid());
+	LLM_SCOPE_BYTAG(SaveGame);
+
+	SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	FString SaveMapName;
+	if (!SaveSystem || !ReadSave(SaveMapName) || !DecompressData())
+	{
+		return false;
+	}
+
+	GatherClasses();
+	GatherReferences();
+	WaitForClasses();
+
+	SerializeActors();
+	SerializeDestroyedActors();
+	SerializeLevels();
+	RestoreSlot();
+
+	const bool bSuccess = !Archive.IsError();
+	ReportStats(bSuccess);
+	return bSuccess;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::OpenForRead(const FString& InSaveName)
+{
+	check(bIsLoading && !bIsTextFormat);
+	LLM_SCOPE_BYTAG(SaveGame);
+
+	SaveName = InSaveName;
+	SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	FString SaveMapName;
+	return SaveSystem && ReadSave(SaveMapName) && DecompressData();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+int32 TSaveGameSerializer<bIsLoading, bIsTextFormat>::FindActor(const FName ActorName) const
+{
+	const int32* EntryIdx = ActorIndexByName.Find(ActorName);
+	return EntryIdx ? *EntryIdx : INDEX_NONE;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+int32 TSaveGameSerializer<bIsLoading, bIsTextFormat>::FindActor(const FGuid& SpawnID) const
+{
+	const int32* EntryIdx = ActorIndexBySpawnID.Find(SpawnID);
+	return EntryIdx ? *EntryIdx : INDEX_NONE;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReadActor(int32 IndexEntry, UObject* PropertiesTarget, TFunctionRef<void(FSaveGameArchive&)> ReadFunction)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_ReadActor);
+	
+	check(bIsLoading && !bIsTextFormat);
+
+	if (!ActorIndex.IsValidIndex(IndexEntry) || Archive.IsError())
+	{
+		return false;
+	}
+
+	Archive.Seek(ActorIndex[IndexEntry].Offset);
+
+	{
+		FStructuredArchive ActorArchive(Formatter);
+		AActor* Actor = nullptr;
+		
+		SerializeActor(ActorArchive.Open().EnterRecord(), Actor, [&](const FName, const FSoftClassPath&, const FGuid&, FStructuredArchive::FRecord& ActorRecord)
+		{
+			const uint64 BeginPosition = Archive.Tell();
+			
+			uint64 DataOffset;
+			Archive << DataOffset;
+
+			if (PropertiesTarget)
+			{
+				PropertiesTarget->SerializeScriptProperties(ActorRecord.EnterField(TEXT("Properties")));
+			}
+
+			// Skip straight to the OnSerialize data, whether or not we read the properties
+			Archive.Seek(BeginPosition + DataOffset);
+
+			FStructuredArchive::FSlot CustomDataSlot = ActorRecord.EnterField(TEXT("Data"));
+			FStructuredArchive::FRecord CustomDataRecord = CustomDataSlot.EnterRecord();
+
+			FSaveGameArchive SaveGameArchive(CustomDataRecord, PropertiesTarget, &FieldRedirects);
+			ReadFunction(SaveGameArchive);
+		});
+		
+		ActorArchive.Close();
+	}
+
+	return !Archive.IsError();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::SaveDump(TSaveGameSerializer<true>& Source, TArray<uint8>& OutData)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SaveDump);
+	LLM_SCOPE_BYTAG(SaveGame);
+	
+	check(!bIsLoading && bIsTextFormat && !SaveGameSubsystem.IsValid());
+
+	MapName = Source.MapName;
+
+	// The versions that the save's data was written with, which is what it has to be read with
+	Archive.SetCustomVersions(Source.Archive.GetCustomVersions());
+
+	// The persistent level, followed by the chunk of each streaming level
+	TArray<FSaveGameDumpLevel> DumpLevels;
+	TMap<FName, TArray<uint8>> DumpLevelChunks;
+
+	FSaveGameDumpLevel& PersistentLevel = DumpLevels.AddDefaulted_GetRef();
+	PersistentLevel.Name = FName(*MapName);
+
+	if (!Source.ReadDump(PersistentLevel, &DumpLevelChunks))
+	{
+		return false;
+	}
+
+	for (TPair<FName, TArray<uint8>>& LevelChunk : DumpLevelChunks)
+	{
+		TSaveGameSerializer<true> LevelSource(nullptr);
+		LevelSource.Data = MoveTemp(LevelChunk.Value);
+
+		FSaveGameDumpLevel& DumpLevel = DumpLevels.AddDefaulted_GetRef();
+		DumpLevel.Name = LevelChunk.Key;
+
+		if (!LevelSource.ReadTables() || !LevelSource.ReadDump(DumpLevel, nullptr))
+		{
+			UE_LOG(LogSaveGame, Warning, TEXT("Couldn't read the chunk of level '%s', its actors won't be dumped"), *LevelChunk.Key.ToString());
+			DumpLevels.Pop();
+		}
+	}
+
+	RootRecord << SA_VALUE(TEXT("Map"), MapName);
+	SerializeVersions();
+
+	int32 NumLevels = DumpLevels.Num();
+	FStructuredArchive::FArray LevelsArray = RootRecord.EnterArray(TEXT("Levels"), NumLevels);
+
+	for (FSaveGameDumpLevel& DumpLevel : DumpLevels)
+	{
+		WriteDumpLevel(LevelsArray.EnterElement().EnterRecord(), DumpLevel);
+	}
+
+	// Be sure to close this, as you'll be missing closed braces for JSON archives
+	StructuredArchive.Close();
+
+	OutData = MoveTemp(Data);
+	return !Archive.IsError();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+TArray<typename TSaveGameSerializer<bIsLoading, bIsTextFormat>::FFieldSpan, TInlineAllocator<8>> TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReadFieldSpans(const FSaveGameArchive& SaveGameArchive)
+{
+	const uint64 StartPosition = SaveGameArchive.StartPosition;
+
+	// The archive has already read its field table, but doesn't keep where the table starts
+	uint32 FieldsOffset;
+	Archive.Seek(StartPosition);
+	Archive << FieldsOffset;
+
+	TArray<FSaveGameArchive::FFieldOffset, TInlineAllocator<8>> Fields(SaveGameArchive.Fields);
+	Algo::SortBy(Fields, &FSaveGameArchive::FFieldOffset::Offset);
+
+	TArray<FFieldSpan, TInlineAllocator<8>> Spans;
+	uint64 FieldPosition = Archive.Tell();
+
+	for (int32 FieldIdx = 0; FieldIdx <= Fields.Num(); ++FieldIdx)
+	{
+		const uint64 NextFieldPosition = StartPosition + (Fields.IsValidIndex(FieldIdx) ? Fields[FieldIdx].Offset : FieldsOffset);
+		
+		Spans.Add({ FieldIdx > 0 ? Fields[FieldIdx - 1].Name : NAME_None, FieldPosition, NextFieldPosition });
+		FieldPosition = FMath::Max(FieldPosition, NextFieldPosition);
+	}
+
+	return Spans;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReadDump(FSaveGameDumpLevel& OutLevel, TMap<FName, TArray<uint8>>* OutLevelChunks)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_ReadDump);
+	
+	check(bIsLoading && !bIsTextFormat);
+
+	// Reads a span of our data as it's stored
+	auto ReadBytes = [this](uint64 Begin, uint64 End, TArray<uint8>& OutBytes)
+	{
+		if (End > Begin && End <= static_cast<uint64>(Archive.TotalSize()))
+		{
+			OutBytes.SetNumUninitialized(static_cast<int32>(End - Begin));
+			Archive.Seek(Begin);
+			Archive.Serialize(OutBytes.GetData(), OutBytes.Num());
+		}
+	};
+
+	{
+		FStructuredArchive DumpArchive(Formatter);
+		FStructuredArchive::FRecord DumpRecord = DumpArchive.Open().EnterRecord();
+
+		int32 NumActors;
+		FStructuredArchive::FArray ActorArray = DumpRecord.EnterArray(TEXT("Actors"), NumActors);
+
+		for (int32 ActorIdx = 0; ActorIdx < NumActors && !Archive.IsError(); ++ActorIdx)
+		{
+			AActor* Actor = nullptr;
+			
+			SerializeActor(ActorArray.EnterElement().EnterRecord(), Actor, [&](const FName ActorName, const FSoftClassPath& Class, const FGuid& SpawnID, FStructuredArchive::FRecord& ActorRecord)
+			{
+				FSaveGameDumpLevel::FActor& DumpActor = OutLevel.Actors.AddDefaulted_GetRef();
+				DumpActor.Name = ActorName;
+				DumpActor.Class = Class;
+				DumpActor.SpawnID = SpawnID;
+
+				const uint64 BeginPosition = Archive.Tell();
+				
+				uint64 DataOffset;
+				Archive << DataOffset;
+
+				ReadBytes(Archive.Tell(), BeginPosition + DataOffset, DumpActor.Properties);
+				Archive.Seek(BeginPosition + DataOffset);
+
+				FStructuredArchive::FSlot CustomDataSlot = ActorRecord.EnterField(TEXT("Data"));
+				FStructuredArchive::FRecord CustomDataRecord = CustomDataSlot.EnterRecord();
+
+				// Without an object, the fields are read as they were saved, without any redirects
+				const FSaveGameArchive SaveGameArchive(CustomDataRecord, nullptr);
+
+				for (const FFieldSpan& FieldSpan : ReadFieldSpans(SaveGameArchive))
+				{
+					// Unnamed data is only kept if there is any, named fields are kept even if they're empty
+					if (!FieldSpan.Name.IsNone() || FieldSpan.End > FieldSpan.Begin)
+					{
+						FSaveGameDumpLevel::FFieldData& DumpField = DumpActor.Fields.AddDefaulted_GetRef();
+						DumpField.Name = FieldSpan.Name;
+						ReadBytes(FieldSpan.Begin, FieldSpan.End, DumpField.Data);
+					}
+				}
+			});
+		}
+
+		int32 NumDestroyedActors;
+		FStructuredArchive::FArray DestroyedActorsArray = DumpRecord.EnterArray(TEXT("DestroyedActors"), NumDestroyedActors);
+
+		for (int32 ActorIdx = 0; ActorIdx < NumDestroyedActors && !Archive.IsError(); ++ActorIdx)
+		{
+			DestroyedActorsArray.EnterElement() << OutLevel.DestroyedActors.AddDefaulted_GetRef();
+		}
+
+		if (OutLevelChunks)
+		{
+			int32 NumLevels;
+			FStructuredArchive::FArray LevelsArray = DumpRecord.EnterArray(TEXT("Levels"), NumLevels);
+
+			for (int32 LevelIdx = 0; LevelIdx < NumLevels && !Archive.IsError(); ++LevelIdx)
+			{
+				FName LevelName;
+				
+				FStructuredArchive::FRecord LevelRecord = LevelsArray.EnterElement().EnterRecord();
+				LevelRecord << SA_VALUE(TEXT("Name"), LevelName);
+
+				Archive << OutLevelChunks->FindOrAdd(LevelName);
+			}
+		}
+
+		DumpArchive.Close();
+	}
+
+	OutLevel.Names = ProxyArchive.GetTables().Names;
+	OutLevel.Paths = ProxyArchive.GetTables().Paths;
+
+	return !Archive.IsError();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::WriteDumpLevel(FStructuredArchive::FRecord LevelRecord, FSaveGameDumpLevel& DumpLevel)
+{
+	check(!bIsLoading && bIsTextFormat);
+
+	// Bytes are written as hex, so that they can be compared against the save itself
+	auto WriteBytes = [](FStructuredArchive::FSlot Slot, const TArray<uint8>& Bytes)
+	{
+		FString Hex = BytesToHex(Bytes.GetData(), Bytes.Num());
+		Slot << Hex;
+	};
+
+	LevelRecord << SA_VALUE(TEXT("Name"), DumpLevel.Name);
+
+	int32 NumActors = DumpLevel.Actors.Num();
+	FStructuredArchive::FArray ActorArray = LevelRecord.EnterArray(TEXT("Actors"), NumActors);
+
+	for (FSaveGameDumpLevel::FActor& DumpActor : DumpLevel.Actors)
+	{
+		FStructuredArchive::FRecord ActorRecord = ActorArray.EnterElement().EnterRecord();
+		ActorRecord << SA_VALUE(TEXT("Name"), DumpActor.Name);
+
+		if (TOptional<FStructuredArchive::FSlot> ClassSlot = ActorRecord.TryEnterField(TEXT("Class"), !DumpActor.Class.IsNull()))
+		{
+			ClassSlot.GetValue() << DumpActor.Class;
+		}
+
+		if (TOptional<FStructuredArchive::FSlot> GuidSlot = ActorRecord.TryEnterField(TEXT("GUID"), DumpActor.SpawnID.IsValid()))
+		{
+			GuidSlot.GetValue() << DumpActor.SpawnID;
+		}
+
+		WriteBytes(ActorRecord.EnterField(TEXT("Properties")), DumpActor.Properties);
+
+		int32 NumFields = DumpActor.Fields.Num();
+		FStructuredArchive::FArray FieldArray = ActorRecord.EnterArray(TEXT("Fields"), NumFields);
+
+		for (FSaveGameDumpLevel::FFieldData& DumpField : DumpActor.Fields)
+		{
+			FStructuredArchive::FRecord FieldRecord = FieldArray.EnterElement().EnterRecord();
+			FieldRecord << SA_VALUE(TEXT("Name"), DumpField.Name);
+			WriteBytes(FieldRecord.EnterField(TEXT("Data")), DumpField.Data);
+		}
+	}
+
+	int32 NumDestroyedActors = DumpLevel.DestroyedActors.Num();
+	FStructuredArchive::FArray DestroyedActorsArray = LevelRecord.EnterArray(TEXT("DestroyedActors"), NumDestroyedActors);
+
+	for (FName& ActorName : DumpLevel.DestroyedActors)
+	{
+		DestroyedActorsArray.EnterElement() << ActorName;
+	}
+
+	int32 NumNames = DumpLevel.Names.Num();
+	FStructuredArchive::FArray NamesArray = LevelRecord.EnterArray(TEXT("Names"), NumNames);
+
+	for (FName& Name : DumpLevel.Names)
+	{
+		NamesArray.EnterElement() << Name;
+	}
+
+	int32 NumPaths = DumpLevel.Paths.Num();
+	FStructuredArchive::FArray PathsArray = LevelRecord.EnterArray(TEXT("Paths"), NumPaths);
+
+	for (FSoftObjectPath& Path : DumpLevel.Paths)
+	{
+		PathsArray.EnterElement() << Path;
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+TUniquePtr<FSaveGameSizeProfile> TSaveGameSerializer<bIsLoading, bIsTextFormat>::ProfileSize()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_ProfileSize);
+	
+	check(bIsLoading && !bIsTextFormat);
+
+	TUniquePtr<FSaveGameSizeProfile> Profile = MakeUnique<FSaveGameSizeProfile>(FileHeader);
+	if (!ReadSizeProfile(*Profile, 0))
+	{
+		return nullptr;
+	}
+
+	return Profile;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReadSizeProfile(FSaveGameSizeProfile& Profile, uint64 PayloadOffset)
+{
+	check(bIsLoading && !bIsTextFormat);
+
+	// Our positions are relative to our data, which for a level chunk is somewhere within the save's payload
+	auto AddSpan = [&Profile, PayloadOffset](ESaveGameSizeCategory Category, const FString& Name, uint64 Begin, uint64 End)
+	{
+		Profile.Add(Category, Name, PayloadOffset + Begin, PayloadOffset + End);
+	};
+
+	// Level actors don't store their class, so it can only be found if the actor is currently loaded
+	const FTopLevelAssetPath LevelAssetPath(FName(*MapName), FName(*FPackageName::GetShortName(MapName)));
+
+	// Only the header has been read so far
+	AddSpan(ESaveGameSizeCategory::Framing, TEXT("Header"), 0, Archive.Tell());
+	
+	{
+		FStructuredArchive ProfileArchive(Formatter);
+		FStructuredArchive::FRecord ProfileRecord = ProfileArchive.Open().EnterRecord();
+
+		uint64 CountPosition = Archive.Tell();
+		
+		int32 NumActors;
+		FStructuredArchive::FArray ActorArray = ProfileRecord.EnterArray(TEXT("Actors"), NumActors);
+		AddSpan(ESaveGameSizeCategory::Framing, TEXT("Counts"), CountPosition, Archive.Tell());
+
+		for (int32 ActorIdx = 0; ActorIdx < NumActors && !Archive.IsError(); ++ActorIdx)
+		{
+			const uint64 RecordPosition = Archive.Tell();
+			FString ClassName;
+			AActor* Actor = nullptr;
+
+			SerializeActor(ActorArray.EnterElement().EnterRecord(), Actor, [&](const FName ActorName, const FSoftClassPath& Class, const FGuid&, FStructuredArchive::FRecord& ActorRecord)
+			{
+				if (!Class.IsNull())
+				{
+					ClassName = Class.ToString();
+				}
+				else if (const UObject* LevelActor = FSoftObjectPath(LevelAssetPath, LEVEL_SUBPATH_PREFIX + ActorName.ToString()).ResolveObject())
+				{
+					ClassName = LevelActor->GetClass()->GetPathName();
+				}
+				else
+				{
+					ClassName = TEXT("(Unloaded Level Actor)");
+				}
+
+				// The actor's name, class and GUID, followed by the DataSize that SerializeActor has just read
+				const uint64 BeginPosition = Archive.Tell();
+				AddSpan(ESaveGameSizeCategory::Framing, TEXT("ActorHeader"), RecordPosition, BeginPosition - sizeof(uint64));
+				AddSpan(ESaveGameSizeCategory::Framing, TEXT("DataSize"), BeginPosition - sizeof(uint64), BeginPosition);
+
+				uint64 DataOffset;
+				Archive << DataOffset;
+
+				AddSpan(ESaveGameSizeCategory::Framing, TEXT("DataOffset"), BeginPosition, Archive.Tell());
+				AddSpan(ESaveGameSizeCategory::Data, TEXT("Properties"), Archive.Tell(), BeginPosition + DataOffset);
+
+				Archive.Seek(BeginPosition + DataOffset);
+
+				FStructuredArchive::FSlot CustomDataSlot = ActorRecord.EnterField(TEXT("Data"));
+				FStructuredArchive::FRecord CustomDataRecord = CustomDataSlot.EnterRecord();
+
+				// Without an object, the fields are read as they were saved, without any redirects
+				const FSaveGameArchive SaveGameArchive(CustomDataRecord, nullptr);
+				const TArray<FFieldSpan, TInlineAllocator<8>> FieldSpans = ReadFieldSpans(SaveGameArchive);
+
+				// The field table's offset comes before the fields, and the table itself after them
+				AddSpan(ESaveGameSizeCategory::Framing, TEXT("FieldTables"), SaveGameArchive.StartPosition, FieldSpans[0].Begin);
+				AddSpan(ESaveGameSizeCategory::Framing, TEXT("FieldTables"), FieldSpans.Last().End, SaveGameArchive.EndPosition);
+
+				for (const FFieldSpan& FieldSpan : FieldSpans)
+				{
+					const FString FieldName = FieldSpan.Name.IsNone() ? TEXT("(Unnamed)") : FieldSpan.Name.ToString();
+
+					AddSpan(ESaveGameSizeCategory::Field, FieldName, FieldSpan.Begin, FieldSpan.End);
+					AddSpan(ESaveGameSizeCategory::Data, TEXT("OnSerialize"), FieldSpan.Begin, FieldSpan.End);
+				}
+			});
+
+			AddSpan(ESaveGameSizeCategory::Class, ClassName, RecordPosition, Archive.Tell());
+		}
+
+		CountPosition = Archive.Tell();
+
+		int32 NumDestroyedActors;
+		FStructuredArchive::FArray DestroyedActorsArray = ProfileRecord.EnterArray(TEXT("DestroyedActors"), NumDestroyedActors);
+		AddSpan(ESaveGameSizeCategory::Framing, TEXT("Counts"), CountPosition, Archive.Tell());
+
+		for (int32 ActorIdx = 0; ActorIdx < NumDestroyedActors && !Archive.IsError(); ++ActorIdx)
+		{
+			const uint64 ActorPosition = Archive.Tell();
+
+			FName ActorName;
+			DestroyedActorsArray.EnterElement() << ActorName;
+
+			AddSpan(ESaveGameSizeCategory::Data, TEXT("DestroyedActors"), ActorPosition, Archive.Tell());
+		}
+
+		// A level chunk doesn't have any levels of its own, so its index immediately follows
+		if (Archive.Tell() < IndexOffset)
+		{
+			CountPosition = Archive.Tell();
+
+			int32 NumLevels;
+			FStructuredArchive::FArray LevelsArray = ProfileRecord.EnterArray(TEXT("Levels"), NumLevels);
+			AddSpan(ESaveGameSizeCategory::Framing, TEXT("Counts"), CountPosition, Archive.Tell());
+
+			for (int32 LevelIdx = 0; LevelIdx < NumLevels && !Archive.IsError(); ++LevelIdx)
+			{
+				const uint64 LevelPosition = Archive.Tell();
+				FName LevelName;
+
+				FStructuredArchive::FRecord LevelRecord = LevelsArray.EnterElement().EnterRecord();
+				LevelRecord << SA_VALUE(TEXT("Name"), LevelName);
+
+				// The chunk's data follows its size
+				const uint64 ChunkPosition = Archive.Tell() + sizeof(int32);
+				AddSpan(ESaveGameSizeCategory::Framing, TEXT("Levels"), LevelPosition, ChunkPosition);
+
+				TSaveGameSerializer<true> LevelSource(nullptr);
+				Archive << LevelSource.Data;
+
+				// The chunk's actors are attributed along with the persistent level's
+				if (!LevelSource.ReadTables() || !LevelSource.ReadSizeProfile(Profile, PayloadOffset + ChunkPosition))
+				{
+					UE_LOG(LogSaveGame, Warning, TEXT("Couldn't read the chunk of level '%s', it will only be profiled as a whole"), *LevelName.ToString());
+					AddSpan(ESaveGameSizeCategory::Data, TEXT("(Unreadable Level Chunk)"), ChunkPosition, Archive.Tell());
+				}
+			}
+		}
+
+		ProfileArchive.Close();
+	}
+
+	if (Archive.IsError())
+	{
+		return false;
+	}
+
+	// The tables are written in this order, after the sections above
+	const uint64 FooterPosition = Archive.TotalSize() - FooterSize;
+	AddSpan(ESaveGameSizeCategory::Framing, TEXT("Index"), IndexOffset, VersionOffset);
+	AddSpan(ESaveGameSizeCategory::Framing, TEXT("Versions"), VersionOffset, PathsOffset);
+	AddSpan(ESaveGameSizeCategory::Framing, TEXT("Paths"), PathsOffset, NamesOffset);
+	AddSpan(ESaveGameSizeCategory::Framing, TEXT("Names"), NamesOffset, FooterPosition);
+	AddSpan(ESaveGameSizeCategory::Framing, TEXT("Footer"), FooterPosition, Archive.TotalSize());
+
+	return true;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::IsSpawnActor(const AActor* Actor) const
+{
+	return SaveGameSubsystem.IsValid() ? SaveGameSubsystem->ActorRegistry->IsSpawnActor(Actor) : Actor->Implements<USaveGameSpawnActor>();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReadSave(FString& OutMapName)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_ReadSave);
+	FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Read);
+	
+	check(SaveSystem);
+
+	// Only the generic save game system keeps slots as files that can be mapped
+	if (LoadStreamingBlocks > 0 && FSaveGameFileHeader::AreSlotsFiles() && GetStreamReader().OpenMapped(GetSaveFilename(), FileHeader))
+	{
+		// Nothing is read into memory until our archive reaches it, but the whole file will be by the time we're done
+		PhaseScope.SetBytes(GetStreamReader().GetMappedSize());
+		OutMapName = FileHeader.MapName;
+		return !OutMapName.IsEmpty();
+	}
+	
+	if (!SaveSystem->LoadGame(false, *SaveName, 0, CompressedData))
+	{
+		return false;
+	}
+
+	PhaseScope.SetBytes(CompressedData.Num());
+
+	return ReadFileHeader(OutMapName);
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReadFileHeader(FString& OutMapName)
+{
+	TConstArrayView<uint8> CompressedBlocks;
+	if (!FileHeader.Read(CompressedData, CompressedBlocks))
+	{
+		return false;
+	}
+
+	// The compressed blocks are between the file header and the block table
+	CompressedDataOffset = CompressedBlocks.GetData() - CompressedData.GetData();
+	OutMapName = FileHeader.MapName;
+	
+	// If we don't have a map, we should bail
+	return !OutMapName.IsEmpty();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::DecompressData()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_DecompressData);
+
+	if (GetStreamReader().IsMapped())
+	{
+		// Each block is decompressed once our archive reaches it
+		GetStreamReader().BeginStreaming(LoadStreamingBlocks);
+		return ReadTables();
+	}
+
+	{
+		FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Decompress);
+		
+		// Decompress the loaded save game data, with the codec that it was saved with
+		Data.SetNumUninitialized(FileHeader.UncompressedSize);
+		
+		const TConstArrayView<uint8> CompressedView = MakeArrayView(CompressedData).Slice(static_cast<int32>(CompressedDataOffset), static_cast<int32>(FileHeader.BlockTableOffset - CompressedDataOffset));
+		if (!FSaveGameCompression::DecompressBlocks(FileHeader.Codec, FileHeader.BlockSize, FileHeader.BlockSizes, CompressedView, Data))
+		{
+			return false;
+		}
+
+		PhaseScope.SetBytes(Data.Num());
+
+		// We don't need the compressed data anymore
+		CompressedData.Empty();
+	}
+
+	return ReadTables();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReadTables()
+{
+	check(bIsLoading);
+	
+	SerializeHeader();
+	
+	{
+		const uint64 InitialPosition = Archive.Tell();
+
+		// After serializing versions, go back to initial position
+		ON_SCOPE_EXIT
+		{
+			Archive.Seek(InitialPosition);
+		};
+
+		if (Archive.TotalSize() - FooterSize < static_cast<int64>(InitialPosition))
+		{
+			// Too small to have a footer, it can't be a valid archive
+			Archive.SetError();
+			return false;
+		}
+
+		Archive.Seek(Archive.TotalSize() - FooterSize);
+		SerializeFooter();
+
+		// Names need to be read before anything else that might reference them
+		Archive.Seek(NamesOffset);
+		SerializeNames();
+
+		// Paths are also fixed up with any CoreRedirects here
+		Archive.Seek(PathsOffset);
+		SerializePaths();
+
+		Archive.Seek(VersionOffset);
+		SerializeVersions();
+
+		Archive.Seek(IndexOffset);
+		SerializeIndex();
+	}
+
+	return !Archive.IsError();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::GatherClasses()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_GatherClasses);
+	
+	check(bIsLoading && !bIsTextFormat);
+
+	TSet<FSoftObjectPath> UniqueClasses;
+
+	for (const FActorIndexEntry& Entry : ActorIndex)
+	{
+		if (!Entry.Class.IsNull())
+		{
+			UniqueClasses.Add(Entry.Class);
+		}
+	}
+
+	ClassPaths = UniqueClasses.Array();
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::GatherReferences()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_GatherReferences);
+	
+	check(bIsLoading && !bIsTextFormat);
+
+	if (!bBatchLoadReferences)
+	{
+		return;
+	}
+
+	TSet<FSoftObjectPath> UniquePaths(ClassPaths);
+
+	// Every path that the save references is in the path table
+	for (const FSoftObjectPath& Path : ProxyArchive.GetTables().Paths)
+	{
+		// Actors (and their components) belong to levels, which aren't ours to load, nor is the save's own map
+		if (Path.IsNull() || Path.GetLongPackageName() == MapName || Path.GetSubPathString().StartsWith(LEVEL_SUBPATH_PREFIX))
+		{
+			continue;
+		}
+
+		UniquePaths.Add(Path);
+	}
+
+	ClassPaths = UniquePaths.Array();
+	bBatchLoadingReferences = true;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::RequestClasses(FStreamableDelegate OnLoaded)
+{
+	check(IsInGameThread());
+
+	if (ClassesHandle.IsValid() || ClassPaths.IsEmpty() || !UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	ClassesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassPaths, MoveTemp(OnLoaded), FStreamableManager::AsyncLoadHighPriority);
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::WaitForClasses()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_WaitForClasses);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Classes);
+	
+	// In case the request hasn't been made yet
+	RequestClasses();
+
+	if (ClassesHandle.IsValid())
+	{
+		ClassesHandle->WaitUntilComplete();
+
+		// Anything that didn't load with the batch won't load when serialized either. If there was no batch (i.e. the
+		// asset manager isn't initialized), unresolved objects are still loaded as they're serialized.
+		if (bBatchLoadingReferences)
+		{
+			ProxyArchive.SetLoadUnresolvedObjects(false);
+		}
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+bool TSaveGameSerializer<bIsLoading, bIsTextFormat>::Travel(const FString& InMapName)
+{
+	check(IsInGameThread());
+
+	// We may have been asynchronously loading while the subsystem was torn down
+	if (!SaveGameSubsystem.IsValid())
+	{
+		return false;
+	}
+	
+	UWorld* World = SaveGameSubsystem->GetWorld();
+
+	if (World->IsInSeamlessTravel())
+	{
+		return false;
+	}
+
+	// When our map has loaded, call the OnMapLoad method
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddThreadSafeSP(this, &TSaveGameSerializer::OnMapLoad);
+	World->SeamlessTravel(InMapName, true);
+
+	return true;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::CancelLoad()
+{
+	check(IsInGameThread());
+	bLoadCancelled = true;
+	
+	if (SaveGameSubsystem.IsValid())
+	{
+		SaveGameSubsystem->OnLoadCompleted(false);
+	}
+
+	TRACE_BOOKMARK(TEXT("End: LoadSaveGame[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::RestoreSlot()
+{
+	check(bIsLoading && SaveGameSubsystem.IsValid());
+
+	// Play time carries on from when the save was made, and the next save keeps the slot's user data
+	SaveGameSubsystem->SetPlaySeconds(FileHeader.PlaySeconds);
+	SaveGameSubsystem->SlotUserData = FileHeader.UserData;
+	SaveGameSubsystem->CurrentSlot = SaveName;
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::ReportStats(bool bSuccess)
+{
+	check(IsInGameThread());
+
+	PhaseStats.TraceCounters();
+
+	if (!bSuccess || !SaveGameSubsystem.IsValid())
+	{
+		return;
+	}
+
+	FSaveGameStats& Stats = SaveGameSubsystem->Stats;
+	const float Seconds = static_cast<float>(PhaseStats.GetTotalSeconds());
+
+	if (bIsLoading)
+	{
+		Stats.LastLoadSeconds = Seconds;
+		Stats.PeakLoadSeconds = FMath::Max(Stats.PeakLoadSeconds, Seconds);
+		Stats.LastLoadBytesRead = PhaseStats.GetBytes(ESaveGamePhase::Read);
+		Stats.LastLoadBytesSerialized = PhaseStats.GetSerializedBytes();
+		Stats.LastLoadActors = PhaseStats.NumActors;
+		++Stats.NumLoads;
+	}
+	else
+	{
+		Stats.LastSaveSeconds = Seconds;
+		Stats.PeakSaveSeconds = FMath::Max(Stats.PeakSaveSeconds, Seconds);
+		Stats.LastSaveGameThreadSeconds = static_cast<float>(PhaseStats.GetGameThreadSeconds());
+		Stats.LastSaveBytesSerialized = PhaseStats.GetSerializedBytes();
+		Stats.LastSaveBytesWritten = PhaseStats.GetBytes(ESaveGamePhase::Compress);
+		Stats.LastSaveActors = PhaseStats.NumActors;
+		Stats.LastCompressionRatio = Stats.LastSaveBytesSerialized > 0 ? static_cast<float>(double(Stats.LastSaveBytesWritten) / Stats.LastSaveBytesSerialized) : 0.f;
+		++Stats.NumSaves;
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+FString TSaveGameSerializer<bIsLoading, bIsTextFormat>::GetSaveName()
+{
+	FString SaveName = TEXT("SaveGame");
+
+	if (bIsTextFormat)
+	{
+		SaveName += TEXT(".json");
 	}
 
 	return SaveName;
 }
 
+template <bool bIsLoading, bool bIsTextFormat>
+FString TSaveGameSerializer<bIsLoading, bIsTextFormat>::GetWorldMapName(const UWorld* World)
+{
+	const UPackage* Package = World->GetOutermost();
+	const FString LoadedMapName = Package->GetLoadedPath().GetPackageName();
+
+	// A world that wasn't loaded from a map (i.e. USaveGameBenchmarkCommandlet's) only has its package's name
+	return LoadedMapName.IsEmpty() ? Package->GetName() : LoadedMapName;
+}
+
 template <bool bIsLoading, bool bIsTextFormat>
 void TSaveGameSerializer<bIsLoading, bIsTextFormat>::OnMapLoad(UWorld* World)
 {
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
 	check(SaveGameSubsystem->GetWorld() == World);
+	LLM_SCOPE_BYTAG(SaveGame);
 
-	// Actually serialize the actors
-	SerializeActors();
-	SerializeDestroyedActors();
+	// If we're loading asynchronously, this is the first point where we actually need the save data
+	LoadTask.Wait();
+
+	bool bSuccess = false;
+	
+	if (bDataReady)
+	{
+		// The classes have been loading in the background, make sure they've all arrived before spawning
+		WaitForClasses();
+		
+		// Actually serialize the actors
+		SerializeActors();
+		SerializeDestroyedActors();
 
-	SaveGameSubsystem->OnLoadCompleted();
+		// Streaming levels are loaded by the subsystem as they're added to the world
+		SerializeLevels();
+		RestoreSlot();
+
+		bSuccess = !Archive.IsError();
+		ReportStats(bSuccess);
+	}
+	else
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("Couldn't decompress save '%s', the map has loaded without it"), *SaveName);
+	}
+
+	SaveGameSubsystem->OnLoadCompleted(bSuccess);
 	
 	TRACE_BOOKMARK(TEXT("End: LoadSaveGame[%s]"), bIsTextFormat ? TEXT("Text") : TEXT("Binary"));
 }
@@ -191,14 +1645,13 @@ template <bool bIsLoading, bool bIsTextFormat>
 void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeHeader()
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeHeader);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Header, &Archive);
 	
 	// If we already have a map name, don't change it
 	if (!bIsLoading && MapName.IsEmpty())
 	{
 		check(SaveGameSubsystem.IsValid());
-		const UWorld* World = SaveGameSubsystem->GetWorld();
-
-		MapName = World->GetOutermost()->GetLoadedPath().GetPackageName();
+		MapName = GetWorldMapName(SaveGameSubsystem->GetWorld());
 	}
 	
 	RootRecord << SA_VALUE(TEXT("Map"), MapName);
@@ -218,10 +1671,6 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeHeader()
 	{
 		// This doesn't have a structured archive serialize method
 		Archive << PackageVersion;
-		
-		// We're a binary archive, so let's serialize where the version is
-		// so that we can read it before loading anything
-		RootRecord << SA_VALUE(TEXT("VersionsOffset"), VersionOffset);
 	}
 
 	if (bIsLoading)
@@ -231,32 +1680,49 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeHeader()
 	}
 }
 
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeFooter()
+{
+	check(!bIsTextFormat);
+
+	// We're a binary archive, so let's serialize where each table is, so that they can be read before loading anything
+	RootRecord << SA_VALUE(TEXT("VersionsOffset"), VersionOffset);
+	RootRecord << SA_VALUE(TEXT("PathsOffset"), PathsOffset);
+	RootRecord << SA_VALUE(TEXT("NamesOffset"), NamesOffset);
+	RootRecord << SA_VALUE(TEXT("IndexOffset"), IndexOffset);
+}
+
 template<bool bIsLoading, bool bIsTextFormat>
 void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActors()
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActors);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Actors, &Archive);
 	
-	// This serialize method assumes that we don't have any streamed/sub levels
-	check(SaveGameSubsystem.IsValid());
-	UWorld* World = SaveGameSubsystem->GetWorld();
-	const FTopLevelAssetPath LevelAssetPath(World->GetCurrentLevel()->GetPackage()->GetFName(), World->GetCurrentLevel()->GetOuter()->GetFName());
-
 	int32 NumActors;
 	TArray<AActor*> Actors;
 	TMap<FGuid, AActor*> SpawnIDs;
+
+	// Spawned actors that haven't finished spawning, they'll finish once their data has been loaded
+	TBitArray<> DeferredActors;
+	const bool bDeferSpawning = bIsLoading && GetDefault<USaveGameSettings>()->ShouldDeferSpawnedActors();
 	
-	const uint64 ActorsPosition = Archive.Tell();
 	const FArchiveFieldName ActorsFieldName(TEXT("Actors"));
 	
 	if (bIsLoading)
 	{
 		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_InitializeActors);
+
+		// Only the actors of our level are serialized, other levels have their own chunk
+		check(SaveGameSubsystem.IsValid());
+		UWorld* World = SaveGameSubsystem->GetWorld();
+		ULevel* ActorLevel = GetLevel();
+		const FTopLevelAssetPath LevelAssetPath(ActorLevel->GetPackage()->GetFName(), ActorLevel->GetOuter()->GetFName());
 		
 		// Iterate through our live actors so that we can map their SpawnIDs
-		for (const TWeakObjectPtr<AActor>& ActorPtr : SaveGameSubsystem->SaveGameActors)
+		for (const TWeakObjectPtr<AActor>& ActorPtr : SaveGameSubsystem->ActorRegistry->GetActors())
 		{
 			AActor* Actor = ActorPtr.Get();
-			if (IsValid(Actor) && Actor->Implements<USaveGameSpawnActor>())
+			if (IsValid(Actor) && SaveGameSubsystem->ActorRegistry->IsSpawnActor(Actor))
 			{
 				const FGuid SpawnID = ISaveGameSpawnActor::Execute_GetSpawnID(Actor);
 
@@ -267,110 +1733,330 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActors()
 			}
 		}
 		
-		FStructuredArchive::FMap ActorMap = RootRecord.EnterMap(ActorsFieldName, NumActors);
-
+		// The index has everything needed to spawn or find each actor, so the actor records don't need to be read yet
+		NumActors = ActorIndex.Num();
 		Actors.SetNumZeroed(NumActors);
+		DeferredActors.Init(false, NumActors);
 
 		// Iterate through the saved actors and spawn or find their live equivalent
 		for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
 		{
 			AActor*& Actor = Actors[ActorIdx];
+			const FActorIndexEntry& Entry = ActorIndex[ActorIdx];
+			
+			ensureAlways(!Entry.Name.IsNone());
 
-			// Populate our actors list with spawned actors or level references to actors
-			SerializeActor(ActorMap, Actor, [&](const FString& ActorName, const FSoftClassPath& Class, const FGuid& SpawnID, FStructuredArchive::FSlot&)
+			if (Entry.Class.IsNull())
+			{
+				// This is a loaded actor (is a level actor), let's find it
+				Actor = FindObjectFast<AActor>(ActorLevel, Entry.Name);
+			}
+			else if (Entry.SpawnID.IsValid() && SpawnIDs.Contains(Entry.SpawnID))
 			{
-				ensureAlways(!ActorName.IsEmpty());
+				Actor = SpawnIDs[Entry.SpawnID];
+			}
+			else
+			{
+				UClass* ActorClass = Entry.Class.TryLoadClass<AActor>();
+
+				// This is a spawned actor, let's spawn it
+				FActorSpawnParameters SpawnParameters;
 
-				if (Class.IsNull())
+				SpawnParameters.OverrideLevel = ActorLevel;
+				SpawnParameters.Name = Entry.Name;
+				SpawnParameters.bNoFail = true;
+				SpawnParameters.bDeferConstruction = bDeferSpawning;
+				
+				Actor = World->SpawnActor(ActorClass, &FTransform::Identity, SpawnParameters);
+				DeferredActors[ActorIdx] = bDeferSpawning;
+
+				if (Entry.SpawnID.IsValid() && SaveGameSubsystem->ActorRegistry->IsSpawnActor(Actor))
 				{
-					// This is a loaded actor (is a level actor), let's find it
-					Actor = FindObjectFast<AActor>(World->GetCurrentLevel(), *ActorName);
+					ISaveGameSpawnActor::Execute_SetSpawnID(Actor, Entry.SpawnID);
 				}
-				else if (SpawnID.IsValid() && SpawnIDs.Contains(SpawnID))
+			}
+
+			if (Entry.SpawnID.IsValid())
+			{
+				const FString ActorSubPath = LEVEL_SUBPATH_PREFIX + Entry.Name.ToString();
+				
+				// We potentially have a spawned actor that other actors reference
+				// If the name has changed, be sure to redirect the old actor path to the new one
+				ProxyArchive.AddRedirect(FSoftObjectPath(LevelAssetPath, ActorSubPath), FSoftObjectPath(Actor));
+			}
+			
+			check(IsValid(Actor));
+		}
+	}
+	else
+	{
+		Actors = MoveTemp(LevelActors);
+		NumActors = Actors.Num();
+	}
+
+	TArray<TConstArrayView<uint8>> CachedActorData;
+	TArray<FActorDataSpan> ParallelActorData;
+	TArray<TUniquePtr<FActorDataWriter>> ActorDataWriters;
+
+	if (!bIsLoading && IncrementalCache)
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_FindCachedActorData);
+		
+		CachedActorData.SetNum(NumActors);
+
+		for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+		{
+			if (IsValid(Actors[ActorIdx]))
+			{
+				CachedActorData[ActorIdx] = IncrementalCache->FindData(Actors[ActorIdx]);
+			}
+		}
+	}
+
+	if (!bIsLoading && !bIsTextFormat)
+	{
+		// Serialize any thread safe actors up front, so that their data can be copied straight into the archive
+		SerializeActorDataInParallel(Actors, CachedActorData, ParallelActorData, ActorDataWriters);
+	}
+	
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActorData);
+		
+		FStructuredArchive::FArray ActorArray = RootRecord.EnterArray(ActorsFieldName, NumActors);
+
+		if (bIsLoading && NumActors != Actors.Num())
+		{
+			// The actor records don't match up with the index
+			Archive.SetError();
+
+			// Deferred actors would otherwise be left half constructed in the level, as they'd never finish spawning
+			for (TConstSetBitIterator<> It(DeferredActors); It; ++It)
+			{
+				Actors[It.GetIndex()]->Destroy();
+			}
+			
+			return;
+		}
+
+		PhaseStats.NumActors += NumActors;
+
+		// When tracing, the time and bytes of each class's actors. Actors that were serialized in parallel only
+		// include the time taken to copy their data in.
+		struct FClassTrace
+		{
+			int32 NumActors = 0;
+			uint64 Cycles = 0;
+			uint64 Bytes = 0;
+		};
+
+		TMap<const UClass*, FClassTrace> ClassTraces;
+		const bool bTraceClasses = UE_TRACE_CHANNELEXPR_IS_ENABLED(SaveGameChannel);
+
+		ON_SCOPE_EXIT
+		{
+			for (const TPair<const UClass*, FClassTrace>& ClassTrace : ClassTraces)
+			{
+				FSaveGamePhaseStats::TraceActorClass(ClassTrace.Key, bIsLoading, ClassTrace.Value.NumActors, ClassTrace.Value.Cycles, ClassTrace.Value.Bytes);
+			}
+		};
+
+		// Actually serialize the actor data and their properties
+		for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+		{
+			AActor* Actor = Actors[ActorIdx];
+			check(IsValid(Actor));
+			
+			// Do the actual serialization of the properties
+			const uint64 RecordOffset = Archive.Tell();
+			const uint64 RecordStartCycles = bTraceClasses ? FPlatformTime::Cycles64() : 0;
+			
+			SerializeActor(ActorArray.EnterElement().EnterRecord(), Actor, [&](const FName ActorName, const FSoftClassPath& Class, const FGuid& SpawnID, FStructuredArchive::FRecord& ActorRecord)
+			{
+				if (!bIsLoading && !bIsTextFormat)
 				{
-					Actor = SpawnIDs[SpawnID];
+					ActorIndex.Add({ ActorName, Class, SpawnID, RecordOffset });
 				}
-				else
+				
+				if (CachedActorData.IsValidIndex(ActorIdx) && !CachedActorData[ActorIdx].IsEmpty())
 				{
-					UClass* ActorClass = Class.TryLoadClass<AActor>();
-
-					// This is a spawned actor, let's spawn it
-					FActorSpawnParameters SpawnParameters;
+					// This actor hasn't changed since the previous save, whose tables we're still using, so its data
+					// can be copied in as is
+					const TConstArrayView<uint8> CachedData = CachedActorData[ActorIdx];
+					Archive.Serialize(const_cast<uint8*>(CachedData.GetData()), CachedData.Num());
+					return;
+				}
 
-					// If we were handling levels, specify it here
-					SpawnParameters.OverrideLevel = World->GetCurrentLevel();
-					SpawnParameters.Name = *ActorName;
-					SpawnParameters.bNoFail = true;
-					
-					Actor = World->SpawnActor(ActorClass, nullptr, nullptr, SpawnParameters);
+				const int64 BeginDataPosition = Archive.Tell();
+				
+				if (ParallelActorData.IsValidIndex(ActorIdx) && ParallelActorData[ActorIdx].WriterIndex != INDEX_NONE)
+				{
+					// This actor's data was already serialized on a worker thread. As the field offsets stored by
+					// FSaveGameArchive are relative to its start, the data can be copied in as is.
+					const FActorDataSpan& DataSpan = ParallelActorData[ActorIdx];
+					Archive.Serialize(ActorDataWriters[DataSpan.WriterIndex]->Data.GetData() + DataSpan.Offset, DataSpan.Size);
+				}
+				else if (bIsLoading && DeferredActors[ActorIdx])
+				{
+					// SerializeActorTransform hands us the actor's transform, rather than moving the unfinished actor
+					FTransform SpawnTransform = FTransform::Identity;
+					SerializeActorData(Actor, ActorRecord, &SpawnTransform, &FieldRedirects);
 
-					if (SpawnID.IsValid() && Actor->Implements<USaveGameSpawnActor>())
-					{
-						ISaveGameSpawnActor::Execute_SetSpawnID(Actor, SpawnID);
-					}
+					// Construction scripts, component registration and BeginPlay now all happen with the loaded state
+					Actor->FinishSpawning(SpawnTransform);
+				}
+				else
+				{
+					SerializeActorData(Actor, ActorRecord, nullptr, &FieldRedirects);
 				}
 
-				if (SpawnID.IsValid())
+				if (IncrementalCache)
 				{
-					const FString ActorSubPath = LEVEL_SUBPATH_PREFIX + ActorName;
-					
-					// We potentially have a spawned actor that other actors reference
-					// If the name has changed, be sure to redirect the old actor path to the new one
-					ProxyArchive.AddRedirect(FSoftObjectPath(LevelAssetPath, ActorSubPath), FSoftObjectPath(Actor));
+					// When streaming, Data only holds what hasn't been streamed out yet, which includes this record
+					const int64 StreamedSize = GetStreamWriter().GetStreamedSize();
+					IncrementalCache->AddData(Actor, TConstArrayView<uint8>(Data.GetData() + BeginDataPosition - StreamedSize, static_cast<int32>(Archive.Tell() - BeginDataPosition)));
 				}
-				
-				check(IsValid(Actor));
 			});
+
+			if (bTraceClasses)
+			{
+				FClassTrace& ClassTrace = ClassTraces.FindOrAdd(Actor->GetClass());
+				++ClassTrace.NumActors;
+				ClassTrace.Cycles += FPlatformTime::Cycles64() - RecordStartCycles;
+				ClassTrace.Bytes += Archive.Tell() - RecordOffset;
+			}
 		}
 	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActorData(AActor* Actor, FStructuredArchive::FRecord ActorRecord, FTransform* SpawnTransform, FSaveGameFieldRedirects* FieldRedirects)
+{
+	FArchive& UnderlyingArchive = ActorRecord.GetUnderlyingArchive();
+	
+	const uint64 BeginPosition = UnderlyingArchive.Tell();
+	uint64 DataOffset = 0;
+
+	if (!bIsTextFormat)
+	{
+		// Pre-write where the OnSerialize data starts, relative to the start of the actor's data
+		UnderlyingArchive << DataOffset;
+	}
+	
+	Actor->SerializeScriptProperties(ActorRecord.EnterField(TEXT("Properties")));
+
+	if (!bIsTextFormat && !bIsLoading)
+	{
+		const uint64 EndPosition = UnderlyingArchive.Tell();
+		DataOffset = EndPosition - BeginPosition;
+
+		UnderlyingArchive.Seek(BeginPosition);
+		UnderlyingArchive << DataOffset;
+		UnderlyingArchive.Seek(EndPosition);
+	}
+
+	FStructuredArchive::FSlot CustomDataSlot = ActorRecord.EnterField(TEXT("Data"));
+	FStructuredArchive::FRecord CustomDataRecord = CustomDataSlot.EnterRecord();
+
+	// Encapsulate the record in something a Blueprint can access 
+	FSaveGameArchive SaveGameArchive(CustomDataRecord, Actor, FieldRedirects);
+	SaveGameArchive.SetSpawnTransform(SpawnTransform);
+
+	if (IsInGameThread())
+	{
+		ISaveGameObject::Execute_OnSerialize(Actor, SaveGameArchive, bIsLoading);
+	}
 	else
 	{
-		NumActors = SaveGameSubsystem->SaveGameActors.Num();
+		// Execute_ goes through ProcessEvent, which isn't safe on a worker. Only classes with a native OnSerialize are
+		// serialized on workers (see CanSerializeOnAnyThread), so it can be called directly.
+		ISaveGameObject* SaveGameObject = static_cast<ISaveGameObject*>(Actor->GetNativeInterfaceAddress(USaveGameObject::StaticClass()));
+		check(SaveGameObject);
+		SaveGameObject->OnSerialize_Implementation(SaveGameArchive, bIsLoading);
 	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActorDataInParallel(const TArray<AActor*>& Actors, const TArray<TConstArrayView<uint8>>& CachedActorData, TArray<FActorDataSpan>& OutActorData, TArray<TUniquePtr<FActorDataWriter>>& OutWriters)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActorDataInParallel);
 	
+	check(!bIsLoading && !bIsTextFormat);
+
+	// Find the actors that are safe to serialize off the game thread, only checking each class once
+	TMap<const UClass*, bool> ThreadSafeClasses;
+	TArray<int32> ParallelActors;
+
+	for (int32 ActorIdx = 0; ActorIdx < Actors.Num(); ++ActorIdx)
 	{
-		QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActorData);
-		
-		if (bIsLoading && !bIsTextFormat)
+		if (!IsValid(Actors[ActorIdx]) || (CachedActorData.IsValidIndex(ActorIdx) && !CachedActorData[ActorIdx].IsEmpty()))
 		{
-			// Go back to the start of the actor data
-			Archive.Seek(ActorsPosition);
+			continue;
 		}
 		
-		FStructuredArchive::FMap ActorMap = RootRecord.EnterMap(ActorsFieldName, NumActors);
+		const UClass* Class = Actors[ActorIdx]->GetClass();
+		
+		const bool* bThreadSafe = ThreadSafeClasses.Find(Class);
+		if (!bThreadSafe)
+		{
+			bThreadSafe = &ThreadSafeClasses.Add(Class, CanSerializeOnAnyThread(Class));
+		}
+
+		if (*bThreadSafe)
+		{
+			ParallelActors.Add(ActorIdx);
+		}
+	}
 
-		auto ActorsIt = SaveGameSubsystem->SaveGameActors.CreateConstIterator();
+	if (ParallelActors.IsEmpty())
+	{
+		return;
+	}
+
+	OutActorData.SetNum(Actors.Num());
+
+	// Each writer serializes a contiguous range of actors into its own buffer
+	const int32 NumWriters = FMath::Clamp(FMath::DivideAndRoundUp(ParallelActors.Num(), MIN_PARALLEL_ACTORS_PER_WRITER), 1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+	const int32 ActorsPerWriter = FMath::DivideAndRoundUp(ParallelActors.Num(), NumWriters);
+
+	OutWriters.Reserve(NumWriters);
+	
+	for (int32 WriterIdx = 0; WriterIdx < NumWriters; ++WriterIdx)
+	{
+		OutWriters.Add(MakeUnique<FActorDataWriter>(ProxyArchive));
+	}
+
+	ParallelFor(NumWriters, [&](int32 WriterIdx)
+	{
+		LLM_SCOPE_BYTAG(SaveGame);
+		FActorDataWriter& Writer = *OutWriters[WriterIdx];
 		
-		// Actually serialize the actor data and their properties
-		for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+		const int32 BeginIdx = WriterIdx * ActorsPerWriter;
+		const int32 EndIdx = FMath::Min(BeginIdx + ActorsPerWriter, ParallelActors.Num());
+
+		for (int32 Idx = BeginIdx; Idx < EndIdx; ++Idx)
 		{
-			AActor* Actor;
+			const int32 ActorIdx = ParallelActors[Idx];
 			
-			if (bIsLoading)
-			{
-				Actor = Actors[ActorIdx];
-			}
-			else
-			{
-				Actor = ActorsIt->Get();
-				++ActorsIt;
-			}
+			FActorDataSpan& DataSpan = OutActorData[ActorIdx];
+			DataSpan.WriterIndex = WriterIdx;
+			DataSpan.Offset = Writer.Archive.Tell();
 
-			check(IsValid(Actor));
-			
-			// Do the actual serialization of the properties
-			SerializeActor(ActorMap, Actor, [&](const FString&, const FSoftClassPath&, const FGuid& SpawnID, FStructuredArchive::FSlot& ActorSlot)
 			{
-				Actor->SerializeScriptProperties(ActorSlot.EnterAttribute(TEXT("Properties")));
+				FStructuredArchive ActorArchive(Writer.Formatter);
+				SerializeActorData(Actors[ActorIdx], ActorArchive.Open().EnterRecord());
+				ActorArchive.Close();
+			}
 
-				FStructuredArchive::FSlot CustomDataSlot = ActorSlot.EnterAttribute(TEXT("Data"));
-				FStructuredArchive::FRecord CustomDataRecord = CustomDataSlot.EnterRecord();
+			DataSpan.Size = Writer.Archive.Tell() - DataSpan.Offset;
+		}
+	});
 
-				// Encapsulate the record in something a Blueprint can access 
-				FSaveGameArchive SaveGameArchive(CustomDataRecord, Actor);
-								
-				ISaveGameObject::Execute_OnSerialize(Actor, SaveGameArchive, bIsLoading);
-			});
+	// Any versions that were used on the workers need to be stored in the save
+	for (const TUniquePtr<FActorDataWriter>& Writer : OutWriters)
+	{
+		for (const FCustomVersion& CustomVersion : Writer->Archive.GetCustomVersions().GetAllVersions())
+		{
+			Archive.SetCustomVersion(CustomVersion.Key, CustomVersion.Version, CustomVersion.GetFriendlyName());
 		}
 	}
 }
@@ -379,27 +2065,27 @@ template <bool bIsLoading, bool bIsTextFormat>
 void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeDestroyedActors()
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeDestroyedActors);
-	
-	check(SaveGameSubsystem.IsValid());
-	const UWorld* World = SaveGameSubsystem->GetWorld();
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::DestroyedActors, &Archive);
 	
 	int32 NumDestroyedActors;
 
 	if (!bIsLoading)
 	{
-		NumDestroyedActors = SaveGameSubsystem->DestroyedLevelActors.Num();
+		NumDestroyedActors = LevelDestroyedActors.Num();
 	}
 
 	FStructuredArchive::FArray DestroyedActorsArray = RootRecord.EnterArray(TEXT("DestroyedActors"), NumDestroyedActors);
 
-	if (bIsLoading)
+	// Only loading needs the subsystem
+	check(!bIsLoading || SaveGameSubsystem.IsValid());
+
+	if (bIsLoading && !Level)
 	{
-		// Allocate our expected number of actors
+		// Allocate our expected number of actors, streaming levels add theirs as they're loaded
 		SaveGameSubsystem->DestroyedLevelActors.Reset();
 		SaveGameSubsystem->DestroyedLevelActors.Reserve(NumDestroyedActors);
 	}
 
-	auto DestroyedActorsIt = SaveGameSubsystem->DestroyedLevelActors.CreateConstIterator();
 	for (int32 ActorIdx = 0; ActorIdx < NumDestroyedActors; ++ActorIdx)
 	{
 		FName ActorName;
@@ -407,11 +2093,9 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeDestroyedActors()
 		if (!bIsLoading)
 		{
 			// Only store the object name without the prefix and full path
-			FString ActorSubPath = (*DestroyedActorsIt).GetSubPathString();
+			FString ActorSubPath = LevelDestroyedActors[ActorIdx].GetSubPathString();
 			ActorSubPath.RemoveFromStart(LEVEL_SUBPATH_PREFIX);
 			ActorName = *ActorSubPath;
-
-			++DestroyedActorsIt;
 		}
 		
 		DestroyedActorsArray.EnterElement() << ActorName;
@@ -419,7 +2103,7 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeDestroyedActors()
 		if (bIsLoading)
 		{
 			// Find the live actor in the level
-			if (AActor* DestroyedActor = FindObjectFast<AActor>(World->GetCurrentLevel(), ActorName))
+			if (AActor* DestroyedActor = FindObjectFast<AActor>(GetLevel(), ActorName))
 			{
 				// Be sure to add any valid destroyed actors back into the array for saving later!
 				SaveGameSubsystem->DestroyedLevelActors.Add(DestroyedActor);
@@ -430,10 +2114,117 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeDestroyedActors()
 	}
 }
 
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeLevels()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeLevels);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Levels, &Archive);
+
+	// Text archives aren't split into levels, and a level's chunk doesn't have levels of its own
+	if (bIsTextFormat || Level)
+	{
+		return;
+	}
+	
+	check(SaveGameSubsystem.IsValid());
+	TMap<FName, TArray<uint8>>& UnloadedLevelChunks = SaveGameSubsystem->LevelChunks;
+
+	int32 NumLevels;
+
+	if (!bIsLoading)
+	{
+		NumLevels = LevelChunks.Num() + UnloadedLevelChunks.Num();
+	}
+
+	FStructuredArchive::FArray LevelsArray = RootRecord.EnterArray(TEXT("Levels"), NumLevels);
+
+	if (bIsLoading)
+	{
+		// Any levels that were unloaded before we loaded no longer apply, nor do chunks that were about to be loaded
+		UnloadedLevelChunks.Reset();
+		SaveGameSubsystem->PendingLevelChunks.Reset();
+
+		for (int32 LevelIdx = 0; LevelIdx < NumLevels && !Archive.IsError(); ++LevelIdx)
+		{
+			FName LevelName;
+			
+			FStructuredArchive::FRecord LevelRecord = LevelsArray.EnterElement().EnterRecord();
+			LevelRecord << SA_VALUE(TEXT("Name"), LevelName);
+
+			// A level's chunk is a complete archive of its own, so is stored as is
+			Archive << UnloadedLevelChunks.FindOrAdd(LevelName);
+		}
+	}
+	else
+	{
+		for (TMap<FName, TArray<uint8>>* Chunks : { &LevelChunks, &UnloadedLevelChunks })
+		{
+			for (TPair<FName, TArray<uint8>>& Chunk : *Chunks)
+			{
+				FStructuredArchive::FRecord LevelRecord = LevelsArray.EnterElement().EnterRecord();
+				LevelRecord << SA_VALUE(TEXT("Name"), Chunk.Key);
+
+				Archive << Chunk.Value;
+			}
+		}
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeIndex()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeIndex);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Tables, &Archive);
+
+	// Text formats can't seek to a record, so don't have an index
+	if (bIsTextFormat)
+	{
+		return;
+	}
+
+	int32 NumEntries = ActorIndex.Num();
+	FStructuredArchive::FArray IndexArray = RootRecord.EnterArray(TEXT("Index"), NumEntries);
+
+	if (bIsLoading)
+	{
+		if (NumEntries < 0)
+		{
+			Archive.SetError();
+			return;
+		}
+		
+		ActorIndex.SetNum(NumEntries);
+		ActorIndexByName.Reset();
+		ActorIndexBySpawnID.Reset();
+	}
+
+	for (int32 EntryIdx = 0; EntryIdx < NumEntries; ++EntryIdx)
+	{
+		FActorIndexEntry& Entry = ActorIndex[EntryIdx];
+		
+		FStructuredArchive::FRecord EntryRecord = IndexArray.EnterElement().EnterRecord();
+		EntryRecord << SA_VALUE(TEXT("Name"), Entry.Name);
+		EntryRecord << SA_VALUE(TEXT("Class"), Entry.Class);
+		EntryRecord << SA_VALUE(TEXT("SpawnID"), Entry.SpawnID);
+		EntryRecord << SA_VALUE(TEXT("Offset"), Entry.Offset);
+
+		if (bIsLoading)
+		{
+			ActorIndexByName.Add(Entry.Name, EntryIdx);
+
+			if (Entry.SpawnID.IsValid())
+			{
+				ActorIndexBySpawnID.Add(Entry.SpawnID, EntryIdx);
+			}
+		}
+	}
+}
+
 template <bool bIsLoading, bool bIsTextFormat>
 void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeVersions()
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeVersions);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Tables, &Archive);
 	
 	FCustomVersionContainer VersionContainer;
 	
@@ -453,17 +2244,43 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeVersions()
 }
 
 template <bool bIsLoading, bool bIsTextFormat>
-void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActor(FStructuredArchive::FMap& ActorMap, AActor*& Actor, TFunction<void(const FString&, const FSoftClassPath&, const FGuid&, FStructuredArchive::FSlot&)>&& BodyFunction)
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializePaths()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializePaths);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Tables, &Archive);
+
+	// Text formats store their paths inline
+	if (!bIsTextFormat)
+	{
+		ProxyArchive.SerializePathTable();
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeNames()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeNames);
+	const FSaveGamePhaseScope PhaseScope(&PhaseStats, ESaveGamePhase::Tables, &Archive);
+
+	// Text formats store their names inline
+	if (!bIsTextFormat)
+	{
+		ProxyArchive.SerializeNameTable();
+	}
+}
+
+template <bool bIsLoading, bool bIsTextFormat>
+void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActor(FStructuredArchive::FRecord ActorRecord, AActor*& Actor, TFunction<void(const FName, const FSoftClassPath&, const FGuid&, FStructuredArchive::FRecord&)>&& BodyFunction)
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_SerializeActor);
 	
-	FString ActorName;
+	FName ActorName;
 	FSoftClassPath Class;
 	FGuid SpawnID;
 
 	if (!bIsLoading)
 	{
-		ActorName = Actor->GetName();
+		ActorName = Actor->GetFName();
 				
 		if (!USaveGameFunctionLibrary::WasObjectLoaded(Actor))
 		{
@@ -471,22 +2288,23 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActor(FStructuredA
 			Class = Actor->GetClass();
 		}
 
-		if (Actor->Implements<USaveGameSpawnActor>())
+		if (IsSpawnActor(Actor))
 		{
 			SpawnID = ISaveGameSpawnActor::Execute_GetSpawnID(Actor);
 		}
 	}
 
-	FStructuredArchive::FSlot ActorSlot = ActorMap.EnterElement(ActorName);
+	// In binary archives, this is stored as an index into the name table
+	ActorRecord << SA_VALUE(TEXT("Name"), ActorName);
 
 	// If we have a class, we're a spawned actor
-	if (TOptional<FStructuredArchive::FSlot> ClassSlot = ActorSlot.TryEnterAttribute(TEXT("Class"), !Class.IsNull()))
+	if (TOptional<FStructuredArchive::FSlot> ClassSlot = ActorRecord.TryEnterField(TEXT("Class"), !Class.IsNull()))
 	{
 		ClassSlot.GetValue() << Class;
 	}
 
 	// If we have a GUID, we're a spawn actor that needs to be mapped by GUID
-	TOptional<FStructuredArchive::FSlot> GuidSlot = ActorSlot.TryEnterAttribute(TEXT("GUID"), SpawnID.IsValid());
+	TOptional<FStructuredArchive::FSlot> GuidSlot = ActorRecord.TryEnterField(TEXT("GUID"), SpawnID.IsValid());
 	if (GuidSlot.IsSet())
 	{
 		GuidSlot.GetValue() << SpawnID;
@@ -502,7 +2320,13 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActor(FStructuredA
 
 	const uint64 BeginDataPosition = Archive.Tell();
 
-	BodyFunction(ActorName, Class, SpawnID, ActorSlot);
+	if (!bIsLoading && !bIsTextFormat)
+	{
+		// Hold this record back from being streamed out until its DataSize has been written
+		GetStreamWriter().Pin(BeginDataPosition - sizeof(DataSize));
+	}
+
+	BodyFunction(ActorName, Class, SpawnID, ActorRecord);
 
 	if (!bIsTextFormat)
 	{
@@ -522,6 +2346,8 @@ void TSaveGameSerializer<bIsLoading, bIsTextFormat>::SerializeActor(FStructuredA
 
 			// Go back to our current position
 			Archive.Seek(EndDataPosition);
+
+			GetStreamWriter().Unpin();
 		}
 	}
 }
@@ -6,15 +6,63 @@
 #include "Serialization/Formatters/JsonArchiveOutputFormatter.h"
 #endif
 
+#include "SaveGameFieldRedirects.h"
+#include "SaveGameFileHeader.h"
+#include "SaveGamePhaseStats.h"
 #include "SaveGameProxyArchive.h"
+#include "SaveGameSettings.h"
+#include "SaveGameStreamReader.h"
+#include "SaveGameStreamWriter.h"
+#include "Engine/StreamableManager.h"
+#include "Tasks/Task.h"
 #include "Templates/ChooseClass.h"
 
+#include <atomic>
+
+class ISaveGameSystem;
 class USaveGameSubsystem;
+class FSaveGameSizeProfile;
+struct FSaveGameArchive;
+
+/** What a binary save (or one of its level chunks) stores, as it's stored, for TSaveGameSerializer::SaveDump */
+struct FSaveGameDumpLevel
+{
+	struct FFieldData
+	{
+		/** None for anything that was written straight to the record, rather than with SerializeField */
+		FName Name;
+		TArray<uint8> Data;
+	};
+
+	struct FActor
+	{
+		FName Name;
+		FSoftClassPath Class;
+		FGuid SpawnID;
+
+		/** The actor's SaveGame properties, as tagged properties */
+		TArray<uint8> Properties;
+
+		/** What the actor wrote in OnSerialize, split at each field of its field table, in the order they were written */
+		TArray<FFieldData> Fields;
+	};
+
+	FName Name;
+	TArray<FActor> Actors;
+	TArray<FName> DestroyedActors;
+
+	/** The names and paths that the actors' data indexes into */
+	TArray<FName> Names;
+	TArray<FSoftObjectPath> Paths;
+};
 
 class FSaveGameSerializer :  public TSharedFromThis<FSaveGameSerializer>
 {
 public:
 	virtual ~FSaveGameSerializer() = default;
+
+	/** Writes an async save that has been left for the game thread to write, see TSaveGameSerializer::SaveAsync */
+	virtual void WriteAsyncSave() {}
 };
 
 /**
@@ -25,7 +73,8 @@ public:
  *		- Map Name
  *		- Engine Versions
  * - Actors
- *		- Actor Name #1:
+ *		- Actor #1:
+ *			- Name
  *			- Class: If spawned
  *			- SpawnID: If implements ISaveGameSpawnActor
  *			- SaveGame Properties
@@ -34,16 +83,39 @@ public:
  * - Destroyed Level Actors
  *		- Actor Name #1
  *		- ...
+ * - Levels: Binary only, a chunk for each streaming level
+ *		- Level #1:
+ *			- Name: The level's package name
+ *			- Chunk: The level's actors, structured like this archive (without Levels), only loaded with the level
+ *		- ...
+ * - Index: Binary only, the Name, Class, SpawnID and offset of each actor's record. When loading, actors are
+ *		spawned or found from this alone, so each actor record is only read once.
  * - Versions
  *		- Version:
  *			- ID
  *			- Version Number
  *		- ...
+ * - Paths: Binary only, every unique soft object path (including actor classes and object references)
+ * - Names: Binary only, every unique name in the archive
+ * - Footer: Binary only, a fixed size footer at the very end of the archive
+ *		- Versions Offset
+ *		- Paths Offset
+ *		- Names Offset
+ *		- Index Offset
+ *
+ * The table offsets are stored in the footer, rather than the header, so that the archive is only ever written front
+ * to back (apart from patching an actor's record while it's written), which lets a save be streamed to disk.
+ *
+ * In binary archives, paths and names are stored as an index into their respective tables.
+ *
+ * Only the persistent level's actors are stored in Actors. Each streaming level is saved into a chunk of its own,
+ * either when it's unloaded (the chunk is then kept by the subsystem), or when the save is made if it's loaded.
+ * Chunks are only loaded when their level is added to the world, so the whole world never needs to be loaded.
  */
 template<bool bIsLoading, bool bIsTextFormat = false>
 class TSaveGameSerializer final : public FSaveGameSerializer
 {
-	using FSaveGameMemoryArchive = typename TChooseClass<bIsLoading, FMemoryReader, FMemoryWriter>::Result;
+	using FSaveGameMemoryArchive = typename TChooseClass<bIsLoading, FSaveGameStreamReader, FSaveGameStreamWriter>::Result;
 
 	static_assert(!bIsLoading || !bIsTextFormat, "This serializer hasn't been implemented for text based loading, only saving!");
 	static_assert(WITH_TEXT_ARCHIVE_SUPPORT || !bIsTextFormat, "Engine isn't compiled with text archive support, cannot use text based TSaveGameSerializer");
@@ -53,19 +125,287 @@ class TSaveGameSerializer final : public FSaveGameSerializer
 		FBinaryArchiveFormatter>::Result;
 
 public:
-	TSaveGameSerializer(USaveGameSubsystem* InSaveGameSubsystem);
+	/**
+	 * @param InSaveGameSubsystem The subsystem that keeps track of the actors to save or load
+	 * @param InLevel If set, only serializes a streaming level's chunk with SaveLevel and LoadLevel
+	 */
+	TSaveGameSerializer(USaveGameSubsystem* InSaveGameSubsystem, ULevel* InLevel = nullptr);
 
-	bool Save();
+	bool Save(ESaveGameType SaveType = ESaveGameType::Manual);
 	bool Load();
 
+	/**
+	 * Reads and decompresses the save on a worker thread. Travel starts as soon as the map name has been read,
+	 * and the save data is only waited upon once the map has loaded.
+	 *
+	 * @return false if the load couldn't be started (i.e. the save doesn't exist)
+	 */
+	bool LoadAsync();
+
+	/**
+	 * Serializes the world on the calling (game) thread, then compresses the data on a worker thread. If slots are
+	 * files (see FSaveGameFileHeader::AreSlotsFiles) the data is written on a worker too, otherwise the returned task
+	 * only compresses, and the subsystem writes the save on the game thread with WriteAsyncSave once it completes.
+	 *
+	 * @param SaveType The kind of save, which selects how the save is compressed
+	 * @param PreviousSave The task of a save that's still in flight, this save will only write once it completes
+	 * @param OnCompleted Called on the game thread once the save has been written (or has failed)
+	 * @return The task that writes this save to disk, or compresses it if the game thread writes it
+	 */
+	UE::Tasks::FTask SaveAsync(ESaveGameType SaveType, const UE::Tasks::FTask& PreviousSave, TUniqueFunction<void(bool)>&& OnCompleted);
+
+	/** Writes an async save on the game thread, once the task returned by SaveAsync has completed */
+	virtual void WriteAsyncSave() override;
+
+	/**
+	 * Serializes a streaming level's chunk, which is stored as is in the Levels section of a save.
+	 *
+	 * @param InLevelActors The level's actors to save
+	 * @param InDestroyedActors The level's actors that have been destroyed
+	 * @param OutData The level's chunk
+	 */
+	bool SaveLevel(TArray<AActor*>&& InLevelActors, TArray<FSoftObjectPath>&& InDestroyedActors, TArray<uint8>& OutData);
+
+	/**
+	 * Loads a streaming level's chunk (from SaveLevel) into the level's actors, once the classes and assets that it
+	 * needs have loaded in the background, rather than blocking the game thread on them as the level streams in.
+	 *
+	 * @param LevelData The level's chunk
+	 * @param OnCompleted Called on the game thread once the chunk has been loaded (or has failed), which is straight
+	 *		away if nothing needs loading first
+	 */
+	void LoadLevelAsync(TArray<uint8>&& LevelData, TUniqueFunction<void(bool)>&& OnCompleted);
+
+	/** The chunk that LoadLevelAsync is loading, i.e. to save it again before it has been loaded */
+	const TArray<uint8>& GetLevelData() const { return Data; }
+
+	/** Stops a LoadLevelAsync that hasn't completed yet, without calling its OnCompleted, and hands its chunk back */
+	TArray<uint8> CancelLoadLevel();
+
+	/**
+	 * Loads the save straight into the subsystem's current world, without travelling to the save's map.
+	 * Used by USaveGameBenchmarkCommandlet, whose world isn't a map that can be travelled to.
+	 */
+	bool LoadWithoutTravel();
+
+	/**
+	 * Reads and decompresses a save (and its index) without travelling, so that actors can be read with ReadActor.
+	 * Used by FSaveGameReader.
+	 */
+	bool OpenForRead(const FString& InSaveName);
+
+	const FString& GetMapName() const { return MapName; }
+
+	/** Saves to (or loads from) a save other than the default one */
+	void SetSaveName(const FString& InSaveName) { SaveName = InSaveName; }
+
+	/** What was measured during each phase of the save or load, only complete once it has finished */
+	const FSaveGamePhaseStats& GetPhaseStats() const { return PhaseStats; }
+
+	/** Returns the index of an actor's record in the save's index, or INDEX_NONE if the save doesn't have the actor */
+	int32 FindActor(const FName ActorName) const;
+	int32 FindActor(const FGuid& SpawnID) const;
+
+	/**
+	 * Reads an actor's record from the save, without needing the actor to exist.
+	 *
+	 * @param IndexEntry The index of the actor's record, from FindActor
+	 * @param PropertiesTarget If set, the actor's SaveGame properties are read into this object, otherwise they're skipped
+	 * @param ReadFunction Reads what it needs out of the data that the actor wrote in ISaveGameObject::OnSerialize
+	 * @return true if the actor was read successfully
+	 */
+	bool ReadActor(int32 IndexEntry, UObject* PropertiesTarget, TFunctionRef<void(FSaveGameArchive&)> ReadFunction);
+
+	/**
+	 * Writes what a binary save stores as text, so that text saves don't need to be made at runtime.
+	 * Used by USaveGameDumpCommandlet, and doesn't need a subsystem.
+	 *
+	 * The actor records are written as they're stored, without creating any actors or calling OnSerialize: each
+	 * actor's name, class and SpawnID, the bytes of its SaveGame properties, and the bytes of each field in its field
+	 * table. Names and paths in those bytes are indices into the name and path tables, which are written with each
+	 * level. Streaming level chunks are written as levels of their own.
+	 *
+	 * @param Source A binary save, opened with OpenForRead
+	 * @param OutData The save as JSON
+	 */
+	bool SaveDump(TSaveGameSerializer<true>& Source, TArray<uint8>& OutData);
+
+	/**
+	 * Attributes every byte of an opened save to the actor class, field, or framing that it belongs to, before and
+	 * after compression. Must be called straight after OpenForRead, as the actor records are walked in order.
+	 * Used by the SaveGame.ProfileSize command.
+	 *
+	 * @return The profile, or null if the save couldn't be read
+	 */
+	TUniquePtr<FSaveGameSizeProfile> ProfileSize();
+
 private:
+	template<bool, bool> friend class TSaveGameSerializer;
+	
 	static FString GetSaveName();
 
+	/** Where the generic (file based) save game system keeps our save, used when streaming saves and loads */
+	FString GetSaveFilename() const;
+
+	/**
+	 * If incremental saves are enabled, picks up the subsystem's cache of actor data and the tables it indexes into.
+	 * Otherwise, the cache is flushed.
+	 */
+	void BeginIncrementalSave();
+
+	/** Serializes the header, actors and versions into Data. Must be called on the game thread. */
+	bool SerializeSave(ESaveGameType SaveType);
+
+	/** Writes each section of the archive, used for saves and level chunks */
+	void SerializeArchive();
+
+	/**
+	 * Splits the subsystem's actors and destroyed actors between the persistent level (which we save) and
+	 * each loaded streaming level, which are each saved into their own chunk.
+	 */
+	void GatherActors();
+
+	/** The level whose actors we're serializing, the persistent level unless we're a streaming level's chunk */
+	ULevel* GetLevel() const;
+
+	/**
+	 * If streaming saves are enabled (see USaveGameSettings::bStreamSaves), opens a temporary file next to the save
+	 * and starts compressing and writing blocks to it as they're serialized. Otherwise, the save is kept in Data.
+	 */
+	void BeginStreaming();
+
+	/** Our archive, when saving */
+	FSaveGameStreamWriter& GetStreamWriter();
+
+	/** Our archive, when loading */
+	FSaveGameStreamReader& GetStreamReader();
+
+	/**
+	 * Compresses Data into CompressedData, or if streaming, finishes writing the blocks and file header.
+	 * Safe to call from any thread once SerializeSave has completed.
+	 */
+	void CompressData();
+
+	/**
+	 * Writes the (compressed if binary) data through the platform's save game system, or if streaming, moves the
+	 * written file over the save. Only safe to call off the game thread if FSaveGameFileHeader::AreSlotsFiles.
+	 */
+	bool WriteData();
+
+	/**
+	 * Reads the save file and its uncompressed file header. When streaming loads, the file is memory mapped instead.
+	 * Only safe to call off the game thread if FSaveGameFileHeader::AreSlotsFiles.
+	 */
+	bool ReadSave(FString& OutMapName);
+
+	/** Reads the uncompressed file header of the save file that has been read into CompressedData */
+	bool ReadFileHeader(FString& OutMapName);
+
+	/**
+	 * The worker thread half of LoadAsync, once the save file has been read: starts travelling, then decompresses
+	 * the save and requests its classes, unless the load has been cancelled in the meantime.
+	 */
+	void LoadAsyncData(bool bReadSave, const FString& SaveMapName);
+
+	/**
+	 * Decompresses the save file, then reads the header and versions. When streaming loads, blocks are instead only
+	 * decompressed as our archive reads them. Safe to call from any thread.
+	 */
+	bool DecompressData();
+
+	/** Reads the header, then the names, paths, versions and index, and seeks back to the actors */
+	bool ReadTables();
+
+	/**
+	 * Reads the class of every spawned actor from the index, so that they can all be loaded in one batch before
+	 * spawning. Safe to call from any thread.
+	 */
+	void GatherClasses();
+
+	/**
+	 * When batch loading references (see USaveGameSettings::bBatchLoadReferences), adds the assets referenced by the
+	 * save to the gathered classes, so they're loaded in the same batch. Safe to call from any thread.
+	 */
+	void GatherReferences();
+
+	/**
+	 * Starts asynchronously loading the gathered classes as one batch. Must be called on the game thread.
+	 * @param OnLoaded Called once the batch has loaded, if a batch was requested
+	 */
+	void RequestClasses(FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** Serializes a level chunk's actors once LoadLevelAsync's classes have loaded */
+	void FinishLoadLevel();
+
+	/** Blocks until the gathered classes have loaded, requesting them first if needed */
+	void WaitForClasses();
+
+	/** Where a field that an actor wrote in OnSerialize is in our archive, see ReadFieldSpans */
+	struct FFieldSpan
+	{
+		/** None for anything that was written straight to the record, rather than with SerializeField */
+		FName Name;
+		uint64 Begin;
+		uint64 End;
+	};
+
+	/**
+	 * Splits what an actor wrote in OnSerialize into its fields, for SaveDump and ProfileSize. Each field runs up
+	 * until the next field (or the field table), in the order that they were written.
+	 *
+	 * @param SaveGameArchive The actor's archive, which has just read its field table
+	 * @return The unnamed data before the first field (which may be empty), then each field. The first span begins
+	 *		after the field table's offset, and the last span ends where the field table begins.
+	 */
+	TArray<FFieldSpan, TInlineAllocator<8>> ReadFieldSpans(const FSaveGameArchive& SaveGameArchive);
+
+	/**
+	 * Reads the actor records of an opened save as they're stored, for SaveDump. Must be called straight after the
+	 * save has been opened, as the records are read in order.
+	 *
+	 * @param OutLevel Receives the records, destroyed actors and tables, but not the level's name
+	 * @param OutLevelChunks If set, receives the save's streaming level chunks (a level chunk doesn't have any)
+	 */
+	bool ReadDump(FSaveGameDumpLevel& OutLevel, TMap<FName, TArray<uint8>>* OutLevelChunks);
+
+	/** Writes a level that was read by ReadDump */
+	void WriteDumpLevel(FStructuredArchive::FRecord LevelRecord, FSaveGameDumpLevel& DumpLevel);
+
+	/**
+	 * Walks the sections and actor records of an opened save (or level chunk) into a profile, for ProfileSize.
+	 * @param PayloadOffset Where our data starts in the save's payload, as level chunks are nested within it
+	 */
+	bool ReadSizeProfile(FSaveGameSizeProfile& Profile, uint64 PayloadOffset);
+
+	/** Whether an actor implements ISaveGameSpawnActor, using the subsystem's cached class flags if we have one */
+	bool IsSpawnActor(const AActor* Actor) const;
+
+	/** The package name of the map that a world was loaded from */
+	static FString GetWorldMapName(const UWorld* World);
+
+	/** Starts travelling to the save's map, the actors will be serialized once it has loaded */
+	bool Travel(const FString& InMapName);
+
+	/** Notifies the subsystem that we've failed to load */
+	void CancelLoad();
+
+	/** Hands the loaded slot's play time and user data to the subsystem */
+	void RestoreSlot();
+
+	/** Updates the subsystem's stats (see USaveGameSubsystem::GetStats) with our completed save or load */
+	void ReportStats(bool bSuccess);
+
 	void OnMapLoad(UWorld* World);
 
-	/** Serializes information about the archive, like Map Name, and position of versioning information */
+	/** Serializes information about the archive, like Map Name and engine versions */
 	void SerializeHeader();
 
+	/** Serializes the position of each table, at the end of a binary archive */
+	void SerializeFooter();
+
+	/** The size of the footer, so that it can be found from the end of the archive */
+	static constexpr int64 FooterSize = 4 * sizeof(uint64);
+
 	/**
 	 * Serializes all of the actors that the SaveGameSubsystem is keeping track of.
 	 * On load, it will also pre-spawn any actors and map any actors with Spawn IDs
@@ -76,12 +416,36 @@ private:
 	/** Serializes any destroyed level actors. On load, level actors will exist again, so this will re-destroy them */
 	void SerializeDestroyedActors();
 
+	/**
+	 * Serializes the chunk of each streaming level. On load, the chunks are handed to the subsystem,
+	 * which loads each one once its level is added to the world.
+	 */
+	void SerializeLevels();
+
+	/**
+	 * Serialized after the actors in a binary archive, the index maps each actor's Name and SpawnID to its record,
+	 * so that a single actor can be read without walking through the rest of the actors.
+	 */
+	void SerializeIndex();
+
 	/**
 	 * Serialized at the end of the archive, the versions are useful for marshaling old data.
 	 * These also contain the versions added by USaveGameFunctionLibrary::UseCustomVersion.
 	 */
 	void SerializeVersions();
 
+	/**
+	 * Serialized before the name table in a binary archive, the path table contains each unique soft object path
+	 * exactly once. When loading, each path is fixed up and redirected once, rather than every time it's referenced.
+	 */
+	void SerializePaths();
+
+	/**
+	 * Serialized at the very end of a binary archive, the name table contains each unique name exactly once.
+	 * Any other names in the archive are stored as an index into this table.
+	 */
+	void SerializeNames();
+
 	/**
 	 * Serializes the actor's data into the structured archive.
 	 * This data always comprises of the actor's object name, and optionally its:
@@ -92,13 +456,75 @@ private:
 	 * It also takes a lambda function that can optionally do some work or serialization. Ultimately, once this
 	 * lambda function is complete, SerializeActor will automatically seek the archive to the end of the actor's data.
 	 *
-	 * @param ActorMap The structured map that the actor data will be written to
+	 * @param ActorRecord The structured record that the actor data will be written to
 	 * @param Actor The live actor that will be serialized
 	 * @param BodyFunction A lambda function that will optionally do some work, whether that be serializing or spawning
 	 */
-	void SerializeActor(FStructuredArchive::FMap& ActorMap, AActor*& Actor, TFunction<void(const FString&, const FSoftClassPath&, const FGuid&, FStructuredArchive::FSlot&)>&& BodyFunction);
+	void SerializeActor(FStructuredArchive::FRecord ActorRecord, AActor*& Actor, TFunction<void(const FName, const FSoftClassPath&, const FGuid&, FStructuredArchive::FRecord&)>&& BodyFunction);
+
+	/**
+	 * Serializes an actor's SaveGame properties, and then any data from ISaveGameObject::OnSerialize.
+	 * In binary archives, this is preceded by the offset to the OnSerialize data, so that the properties can be skipped.
+	 *
+	 * @param SpawnTransform When loading an actor that hasn't finished spawning, receives the actor's loaded transform
+	 * @param FieldRedirects When loading, the field redirects that have already been found for the actor's class
+	 */
+	static void SerializeActorData(AActor* Actor, FStructuredArchive::FRecord ActorRecord, FTransform* SpawnTransform = nullptr, FSaveGameFieldRedirects* FieldRedirects = nullptr);
+
+	/** Where an actor's record is in the archive */
+	struct FActorIndexEntry
+	{
+		FName Name;
+		FSoftClassPath Class;
+		FGuid SpawnID;
+		uint64 Offset = 0;
+	};
+
+	/** An archive for serializing actor data on a worker thread, it shares its name and path tables with ours */
+	struct FActorDataWriter
+	{
+		explicit FActorDataWriter(TSaveGameProxyArchive<bIsLoading>& TableOwner)
+			: Archive(Data)
+			, ProxyArchive(Archive, TableOwner)
+			, Formatter(ProxyArchive)
+		{}
+		
+		TArray<uint8> Data;
+		FMemoryWriter Archive;
+		TSaveGameProxyArchive<bIsLoading> ProxyArchive;
+		FBinaryArchiveFormatter Formatter;
+	};
+
+	/** Where an actor's data was serialized to by an FActorDataWriter */
+	struct FActorDataSpan
+	{
+		int32 WriterIndex = INDEX_NONE;
+		int64 Offset = 0;
+		int64 Size = 0;
+	};
+
+	/**
+	 * Serializes the data of actors whose class opted in with ISaveGameObject::CanSerializeOnAnyThread, in parallel.
+	 * The rest of the actor (and its DataSize) is still serialized by SerializeActor, which copies in this data.
+	 *
+	 * @param Actors The actors that are being saved, in the order they'll be saved
+	 * @param CachedActorData Data reused from the previous save for each actor (if any), these actors are skipped
+	 * @param OutActorData Where each actor's data was written, only valid for actors that were serialized in parallel
+	 * @param OutWriters The archives that hold the serialized data
+	 */
+	void SerializeActorDataInParallel(const TArray<AActor*>& Actors, const TArray<TConstArrayView<uint8>>& CachedActorData, TArray<FActorDataSpan>& OutActorData, TArray<TUniquePtr<FActorDataWriter>>& OutWriters);
 
 	const TWeakObjectPtr<USaveGameSubsystem> SaveGameSubsystem;
+
+	/** If set, we're a streaming level's chunk */
+	ULevel* Level;
+
+	/** When saving, the actors and destroyed actors of our level */
+	TArray<AActor*> LevelActors;
+	TArray<FSoftObjectPath> LevelDestroyedActors;
+
+	/** When saving, the chunks of the streaming levels that are currently loaded */
+	TMap<FName, TArray<uint8>> LevelChunks;
 	TArray<uint8> Data;
 	FSaveGameMemoryArchive Archive;
 	TSaveGameProxyArchive<bIsLoading> ProxyArchive;
@@ -110,4 +536,62 @@ private:
 
 	FString MapName;
 	uint64 VersionOffset;
+	uint64 PathsOffset;
+	uint64 NamesOffset;
+	uint64 IndexOffset;
+
+	/** The name of the save that we're writing to or reading from */
+	FString SaveName;
+
+	TArray<FActorIndexEntry> ActorIndex;
+	TMap<FName, int32> ActorIndexByName;
+	TMap<FGuid, int32> ActorIndexBySpawnID;
+
+	ISaveGameSystem* SaveSystem;
+
+	/** When an async save is written on the game thread, called once it has been, see WriteAsyncSave */
+	TUniqueFunction<void(bool)> OnAsyncSaveCompleted;
+
+	/** When making an incremental save, the subsystem's cache of each actor's data from the previous save */
+	TSharedPtr<struct FSaveGameIncrementalCache> IncrementalCache;
+	TArray<uint8> CompressedData;
+	int64 CompressedDataOffset;
+
+	FSaveGameFileHeader FileHeader;
+	FSaveGameCompressionSettings CompressionSettings;
+	int32 CompressionBlockSize;
+
+	/** When streaming, compresses and writes each block of Data to StreamFilename as it's handed off by our archive */
+	TUniquePtr<FSaveGameBlockWriter> BlockWriter;
+	FString StreamFilename;
+	bool bStreamSucceeded;
+
+	/** When loading, the number of decompressed blocks our archive keeps if streaming the load, otherwise zero */
+	int32 LoadStreamingBlocks;
+
+	/** Each phase of the save or load, which the subsystem's stats are updated from once it completes */
+	FSaveGamePhaseStats PhaseStats;
+
+	/** When loading, the field redirects found for each class, so they're only looked up once for all of its actors */
+	FSaveGameFieldRedirects FieldRedirects;
+
+	/** The classes of the save's spawned actors (and any referenced assets), and the request that's loading them */
+	TArray<FSoftObjectPath> ClassPaths;
+	TSharedPtr<FStreamableHandle> ClassesHandle;
+
+	/** When loading a level chunk asynchronously, called once it has been loaded, see LoadLevelAsync */
+	TUniqueFunction<void(bool)> OnLevelLoaded;
+
+	/** When loading, whether the save's referenced assets are loaded with its classes (see GatherReferences) */
+	bool bBatchLoadReferences;
+
+	/** Whether ClassPaths includes the save's referenced assets, see GatherReferences */
+	bool bBatchLoadingReferences;
+
+	/** When loading asynchronously, the task that's reading and decompressing the save */
+	UE::Tasks::FTask LoadTask;
+	bool bDataReady;
+
+	/** Set on the game thread by CancelLoad, so that LoadTask can stop early */
+	std::atomic<bool> bLoadCancelled;
 };
@@ -2,6 +2,14 @@
 
 #include "SaveGameSettings.h"
 
+USaveGameSettings::USaveGameSettings()
+{
+	Compression.Add(ESaveGameType::Manual, FSaveGameCompressionSettings(ESaveGameCompressionCodec::Oodle, ESaveGameCompressionLevel::Optimal));
+	Compression.Add(ESaveGameType::Autosave, FSaveGameCompressionSettings(ESaveGameCompressionCodec::Oodle, ESaveGameCompressionLevel::Fastest));
+	Compression.Add(ESaveGameType::Quicksave, FSaveGameCompressionSettings(ESaveGameCompressionCodec::Oodle, ESaveGameCompressionLevel::Fast));
+	Compression.Add(ESaveGameType::Checkpoint, FSaveGameCompressionSettings(ESaveGameCompressionCodec::Oodle, ESaveGameCompressionLevel::Fast));
+}
+
 FGuid USaveGameSettings::GetVersionId(const UEnum* VersionEnum) const
 {
 	if (CachedVersions.IsEmpty())
@@ -25,6 +33,16 @@ FGuid USaveGameSettings::GetVersionId(const UEnum* VersionEnum) const
 	return FGuid();
 }
 
+FSaveGameCompressionSettings USaveGameSettings::GetCompressionSettings(ESaveGameType SaveType) const
+{
+	if (const FSaveGameCompressionSettings* Settings = Compression.Find(SaveType))
+	{
+		return *Settings;
+	}
+
+	return FSaveGameCompressionSettings();
+}
+
 #if WITH_EDITOR
 void USaveGameSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
@@ -0,0 +1,259 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameSizeProfile.h"
+
+#include "SaveGameFileHeader.h"
+#include "SaveGamePlugin.h"
+#include "SaveGameSerializer.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+
+FSaveGameSizeProfile::FSaveGameSizeProfile(const FSaveGameFileHeader& FileHeader)
+	: BlockSize(FileHeader.BlockSize)
+	, CompressedBlockSizes(FileHeader.BlockSizes)
+	, PayloadBytes(FileHeader.UncompressedSize)
+	, FileBytes(0)
+{
+	int64 CompressedBytes = 0;
+	for (const int32 CompressedBlockSize : CompressedBlockSizes)
+	{
+		CompressedBytes += CompressedBlockSize;
+	}
+
+	// The header is everything before the blocks, and the block table is its count and sizes
+	const int64 BlockTableBytes = sizeof(int32) + CompressedBlockSizes.Num() * sizeof(int32);
+	AddFileBytes(TEXT("FileHeader"), FileHeader.BlockTableOffset - CompressedBytes);
+	AddFileBytes(TEXT("BlockTable"), BlockTableBytes);
+
+	FileBytes = FileHeader.BlockTableOffset + BlockTableBytes;
+}
+
+void FSaveGameSizeProfile::Add(ESaveGameSizeCategory Category, const FString& Name, uint64 Begin, uint64 End)
+{
+	if (End <= Begin)
+	{
+		return;
+	}
+
+	FEntry& Entry = FindOrAddEntry(Category, Name);
+	++Entry.Count;
+	Entry.Bytes += End - Begin;
+	Entry.CompressedBytes += GetCompressedBytes(Begin, End);
+}
+
+void FSaveGameSizeProfile::AddFileBytes(const FString& Name, int64 Bytes)
+{
+	FEntry& Entry = FindOrAddEntry(ESaveGameSizeCategory::Framing, Name);
+	++Entry.Count;
+	Entry.CompressedBytes += Bytes;
+}
+
+double FSaveGameSizeProfile::GetCompressedBytes(uint64 Begin, uint64 End) const
+{
+	if (BlockSize <= 0)
+	{
+		return 0.0;
+	}
+
+	double CompressedBytes = 0.0;
+
+	const int64 FirstBlockIdx = static_cast<int64>(Begin) / BlockSize;
+	const int64 LastBlockIdx = FMath::Min<int64>((static_cast<int64>(End) - 1) / BlockSize, CompressedBlockSizes.Num() - 1);
+
+	// Each block's share of the span, at that block's compression ratio
+	for (int64 BlockIdx = FirstBlockIdx; BlockIdx <= LastBlockIdx; ++BlockIdx)
+	{
+		const int64 BlockBegin = BlockIdx * BlockSize;
+		const int64 BlockEnd = FMath::Min(BlockBegin + BlockSize, PayloadBytes);
+
+		const int64 Overlap = FMath::Min(static_cast<int64>(End), BlockEnd) - FMath::Max(static_cast<int64>(Begin), BlockBegin);
+		if (Overlap > 0 && BlockEnd > BlockBegin)
+		{
+			CompressedBytes += static_cast<double>(Overlap) * CompressedBlockSizes[BlockIdx] / (BlockEnd - BlockBegin);
+		}
+	}
+
+	return CompressedBytes;
+}
+
+TArray<FSaveGameSizeProfile::FEntry> FSaveGameSizeProfile::GetSortedEntries(ESaveGameSizeSort SortBy) const
+{
+	TArray<FEntry> SortedEntries = Entries;
+
+	SortedEntries.Sort([SortBy](const FEntry& A, const FEntry& B)
+	{
+		// Keep each category together, in the order they're declared
+		if (A.Category != B.Category)
+		{
+			return A.Category < B.Category;
+		}
+
+		switch (SortBy)
+		{
+		case ESaveGameSizeSort::CompressedBytes:
+			return A.CompressedBytes > B.CompressedBytes;
+		case ESaveGameSizeSort::CompressionRatio:
+			return A.GetCompressionRatio() > B.GetCompressionRatio();
+		case ESaveGameSizeSort::Count:
+			return A.Count > B.Count;
+		case ESaveGameSizeSort::Name:
+			return A.Name < B.Name;
+		default:
+			return A.Bytes > B.Bytes;
+		}
+	});
+
+	return SortedEntries;
+}
+
+TArray<FString> FSaveGameSizeProfile::GetReport(ESaveGameSizeSort SortBy) const
+{
+	constexpr int32 NumCategories = static_cast<int32>(ESaveGameSizeCategory::Num);
+
+	// Each entry's share is of its own category, as the categories overlap
+	int64 CategoryBytes[NumCategories] = {};
+	double CategoryCompressedBytes[NumCategories] = {};
+
+	for (const FEntry& Entry : Entries)
+	{
+		CategoryBytes[static_cast<int32>(Entry.Category)] += Entry.Bytes;
+		CategoryCompressedBytes[static_cast<int32>(Entry.Category)] += Entry.CompressedBytes;
+	}
+
+	TArray<FString> Lines = { TEXT("Category,Name,Count,Bytes,BytesPercent,CompressedBytes,CompressedPercent,CompressionRatio") };
+
+	for (const FEntry& Entry : GetSortedEntries(SortBy))
+	{
+		const int32 CategoryIdx = static_cast<int32>(Entry.Category);
+
+		Lines.Add(FString::Printf(TEXT("%s,\"%s\",%d,%lld,%.2f,%.0f,%.2f,%.3f"), GetCategoryName(Entry.Category), *Entry.Name.Replace(TEXT("\""), TEXT("\"\"")),
+			Entry.Count, Entry.Bytes, CategoryBytes[CategoryIdx] > 0 ? 100.0 * Entry.Bytes / CategoryBytes[CategoryIdx] : 0.0,
+			Entry.CompressedBytes, CategoryCompressedBytes[CategoryIdx] > 0.0 ? 100.0 * Entry.CompressedBytes / CategoryCompressedBytes[CategoryIdx] : 0.0,
+			Entry.GetCompressionRatio()));
+	}
+
+	return Lines;
+}
+
+const TCHAR* FSaveGameSizeProfile::GetCategoryName(ESaveGameSizeCategory Category)
+{
+	switch (Category)
+	{
+	case ESaveGameSizeCategory::Class:
+		return TEXT("Class");
+	case ESaveGameSizeCategory::Field:
+		return TEXT("Field");
+	case ESaveGameSizeCategory::Data:
+		return TEXT("Data");
+	case ESaveGameSizeCategory::Framing:
+		return TEXT("Framing");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+bool FSaveGameSizeProfile::ParseSort(const FString& Name, ESaveGameSizeSort& OutSortBy)
+{
+	static const TPair<const TCHAR*, ESaveGameSizeSort> SortNames[] =
+	{
+		{ TEXT("Bytes"), ESaveGameSizeSort::Bytes },
+		{ TEXT("CompressedBytes"), ESaveGameSizeSort::CompressedBytes },
+		{ TEXT("CompressionRatio"), ESaveGameSizeSort::CompressionRatio },
+		{ TEXT("Count"), ESaveGameSizeSort::Count },
+		{ TEXT("Name"), ESaveGameSizeSort::Name }
+	};
+
+	for (const TPair<const TCHAR*, ESaveGameSizeSort>& SortName : SortNames)
+	{
+		if (Name.Equals(SortName.Key, ESearchCase::IgnoreCase))
+		{
+			OutSortBy = SortName.Value;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FSaveGameSizeProfile::FEntry& FSaveGameSizeProfile::FindOrAddEntry(ESaveGameSizeCategory Category, const FString& Name)
+{
+	int32& EntryIdx = EntryIndices[static_cast<int32>(Category)].FindOrAdd(Name, INDEX_NONE);
+
+	if (EntryIdx == INDEX_NONE)
+	{
+		EntryIdx = Entries.Num();
+
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Category = Category;
+		Entry.Name = Name;
+	}
+
+	return Entries[EntryIdx];
+}
+
+/**
+ * Attributes the bytes of an existing save to each actor class, field, and the framing around them, and writes the
+ * report to the project's Profiling directory.
+ * Usage: SaveGame.ProfileSize [SaveName] [Bytes|CompressedBytes|CompressionRatio|Count|Name] [Top]
+ */
+static void ProfileSize(const TArray<FString>& Args)
+{
+	const FString SaveName = Args.IsValidIndex(0) ? Args[0] : TEXT("SaveGame");
+	const int32 NumTop = Args.IsValidIndex(2) ? FMath::Max(0, FCString::Atoi(*Args[2])) : 10;
+
+	ESaveGameSizeSort SortBy = ESaveGameSizeSort::Bytes;
+	if (Args.IsValidIndex(1) && !FSaveGameSizeProfile::ParseSort(Args[1], SortBy))
+	{
+		UE_LOG(LogSaveGame, Warning, TEXT("ProfileSize: Unknown sort '%s', sorting by Bytes"), *Args[1]);
+	}
+
+	TSaveGameSerializer<true> Serializer(nullptr);
+	if (!Serializer.OpenForRead(SaveName))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("ProfileSize: Couldn't read save '%s'"), *SaveName);
+		return;
+	}
+
+	const TUniquePtr<FSaveGameSizeProfile> Profile = Serializer.ProfileSize();
+	if (!Profile)
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("ProfileSize: Failed to profile save '%s', it may be corrupt"), *SaveName);
+		return;
+	}
+
+	const FString OutputPath = FPaths::ProfilingDir() / TEXT("SaveGame") / FString::Printf(TEXT("%s-Size-%s.csv"), *SaveName, *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringArrayToFile(Profile->GetReport(SortBy), *OutputPath))
+	{
+		UE_LOG(LogSaveGame, Error, TEXT("ProfileSize: Couldn't write '%s'"), *OutputPath);
+		return;
+	}
+
+	UE_LOG(LogSaveGame, Display, TEXT("ProfileSize: '%s', %lld bytes uncompressed, %lld bytes on disk, wrote '%s'"), *SaveName,
+		Profile->GetPayloadBytes(), Profile->GetFileBytes(), *OutputPath);
+	UE_LOG(LogSaveGame, Display, TEXT("%-8s %-48s %8s %12s %12s %8s"), TEXT("Category"), TEXT("Name"), TEXT("Count"), TEXT("Bytes"), TEXT("Compressed"), TEXT("Ratio"));
+
+	// Only the top entries of each category, the report has the rest
+	ESaveGameSizeCategory Category = ESaveGameSizeCategory::Num;
+	int32 NumLogged = 0;
+
+	for (const FSaveGameSizeProfile::FEntry& Entry : Profile->GetSortedEntries(SortBy))
+	{
+		if (Entry.Category != Category)
+		{
+			Category = Entry.Category;
+			NumLogged = 0;
+		}
+
+		if (NumLogged++ < NumTop)
+		{
+			UE_LOG(LogSaveGame, Display, TEXT("%-8s %-48s %8d %12lld %12.0f %8.3f"), FSaveGameSizeProfile::GetCategoryName(Entry.Category),
+				*Entry.Name.Right(48), Entry.Count, Entry.Bytes, Entry.CompressedBytes, Entry.GetCompressionRatio());
+		}
+	}
+}
+
+static FAutoConsoleCommand ProfileSizeCommand(
+	TEXT("SaveGame.ProfileSize"),
+	TEXT("Attributes the bytes of an existing save to each actor class, field, and framing, before and after compression. Usage: SaveGame.ProfileSize [SaveName] [Bytes|CompressedBytes|CompressionRatio|Count|Name] [Top]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ProfileSize));
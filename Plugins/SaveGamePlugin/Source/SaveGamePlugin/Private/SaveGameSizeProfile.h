@@ -0,0 +1,102 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSaveGameFileHeader;
+
+/** What a profiled span of a save is attributed to */
+enum class ESaveGameSizeCategory : uint8
+{
+	/** Each actor class's records, including their framing */
+	Class,
+
+	/** Each field that was written with FSaveGameArchive::SerializeField, across every class */
+	Field,
+
+	/** What the actors actually wrote, i.e. their SaveGame properties and their OnSerialize fields */
+	Data,
+
+	/** Everything that's needed to find and read the data, i.e. DataSize, field tables, and the name table */
+	Framing,
+
+	Num
+};
+
+/** How FSaveGameSizeProfile::GetReport orders each category's entries */
+enum class ESaveGameSizeSort : uint8
+{
+	Bytes,
+	CompressedBytes,
+	CompressionRatio,
+	Count,
+	Name
+};
+
+/**
+ * Attributes the bytes of a binary save to the things that wrote them, see TSaveGameSerializer::ProfileSize.
+ *
+ * The Data and Framing entries cover the whole save between them, the Class entries cover the actor records, and the
+ * Field entries cover the OnSerialize data. Compressed bytes are estimated from the compression ratio of each block
+ * that a span falls in, as blocks are compressed as a whole.
+ */
+class FSaveGameSizeProfile
+{
+public:
+	struct FEntry
+	{
+		ESaveGameSizeCategory Category;
+		FString Name;
+
+		/** The number of spans (i.e. actors of a class, or writes of a field) that were attributed to this */
+		int32 Count = 0;
+
+		int64 Bytes = 0;
+		double CompressedBytes = 0.0;
+
+		double GetCompressionRatio() const { return Bytes > 0 ? CompressedBytes / Bytes : 0.0; }
+	};
+
+	explicit FSaveGameSizeProfile(const FSaveGameFileHeader& FileHeader);
+
+	/**
+	 * Attributes a span of the save's payload (before compression).
+	 * @param Begin The start of the span, relative to the start of the payload
+	 * @param End The end of the span, exclusive
+	 */
+	void Add(ESaveGameSizeCategory Category, const FString& Name, uint64 Begin, uint64 End);
+
+	/** Attributes bytes that are only in the file, and aren't compressed (i.e. the file header and block table) */
+	void AddFileBytes(const FString& Name, int64 Bytes);
+
+	/** The estimated size of a span of the payload once compressed */
+	double GetCompressedBytes(uint64 Begin, uint64 End) const;
+
+	int64 GetPayloadBytes() const { return PayloadBytes; }
+	int64 GetFileBytes() const { return FileBytes; }
+
+	/** Each category's entries, sorted by SortBy */
+	TArray<FEntry> GetSortedEntries(ESaveGameSizeSort SortBy) const;
+
+	/** The sorted entries as CSV, with each entry's share of its category */
+	TArray<FString> GetReport(ESaveGameSizeSort SortBy) const;
+
+	static const TCHAR* GetCategoryName(ESaveGameSizeCategory Category);
+
+	/** Parses the name of an ESaveGameSizeSort, i.e. "CompressedBytes" */
+	static bool ParseSort(const FString& Name, ESaveGameSizeSort& OutSortBy);
+
+private:
+	FEntry& FindOrAddEntry(ESaveGameSizeCategory Category, const FString& Name);
+
+	TArray<FEntry> Entries;
+	TMap<FString, int32> EntryIndices[static_cast<int32>(ESaveGameSizeCategory::Num)];
+
+	/** The uncompressed size of each block, and their compressed sizes */
+	int64 BlockSize;
+	TArray<int32> CompressedBlockSizes;
+
+	int64 PayloadBytes;
+	int64 FileBytes;
+};
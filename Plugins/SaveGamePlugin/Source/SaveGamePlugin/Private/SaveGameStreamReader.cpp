@@ -0,0 +1,173 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameStreamReader.h"
+
+#include "SaveGameCompression.h"
+#include "HAL/PlatformFileManager.h"
+
+FSaveGameStreamReader::FSaveGameStreamReader(const TArray<uint8>& InBytes)
+	: Bytes(InBytes)
+{
+	SetIsLoading(true);
+}
+
+bool FSaveGameStreamReader::OpenMapped(const FString& Filename, FSaveGameFileHeader& OutFileHeader)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_OpenMapped);
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (MappedFile)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (!MappedRegion || MappedRegion->GetMappedSize() > MAX_int32)
+	{
+		MappedRegion.Reset();
+		MappedFile.Reset();
+		return false;
+	}
+
+	const TConstArrayView<uint8> FileData(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	if (!FileHeader.Read(FileData, CompressedBlocks))
+	{
+		MappedRegion.Reset();
+		MappedFile.Reset();
+		return false;
+	}
+
+	OutFileHeader = FileHeader;
+	return true;
+}
+
+void FSaveGameStreamReader::BeginStreaming(int32 InMaxBlocks)
+{
+	check(IsMapped() && !bStreaming);
+
+	// Find where each block starts, so they can be decompressed in any order
+	BlockOffsets.Reset(FileHeader.BlockSizes.Num());
+
+	int64 BlockOffset = 0;
+	for (const int32 CompressedSize : FileHeader.BlockSizes)
+	{
+		BlockOffsets.Add(BlockOffset);
+		BlockOffset += CompressedSize;
+	}
+
+	if (FileHeader.BlockSize <= 0 || BlockOffset != CompressedBlocks.Num() || FileHeader.BlockSizes.ContainsByPredicate([](int32 Size) { return Size < 0; })
+		|| FileHeader.BlockSizes.Num() != FMath::DivideAndRoundUp(FileHeader.UncompressedSize, static_cast<int64>(FileHeader.BlockSize)))
+	{
+		// The block table doesn't match up with the blocks
+		SetError();
+	}
+
+	MaxBlocks = FMath::Max(1, InMaxBlocks);
+	bStreaming = true;
+}
+
+void FSaveGameStreamReader::Serialize(void* Data, int64 Num)
+{
+	if (!Num || IsError())
+	{
+		return;
+	}
+
+	if (Offset < 0 || Offset + Num > TotalSize())
+	{
+		SetError();
+		return;
+	}
+
+	if (!bStreaming)
+	{
+		FMemory::Memcpy(Data, Bytes.GetData() + Offset, Num);
+		Offset += Num;
+		return;
+	}
+
+	uint8* Dest = static_cast<uint8*>(Data);
+
+	// Reads can span more than one block
+	while (Num > 0)
+	{
+		const int32 BlockIdx = static_cast<int32>(Offset / FileHeader.BlockSize);
+		const int64 BlockOffset = Offset - static_cast<int64>(BlockIdx) * FileHeader.BlockSize;
+
+		const TArray<uint8>* Block = GetBlock(BlockIdx);
+		if (!Block)
+		{
+			SetError();
+			return;
+		}
+
+		const int64 NumToCopy = FMath::Min(Num, Block->Num() - BlockOffset);
+		FMemory::Memcpy(Dest, Block->GetData() + BlockOffset, NumToCopy);
+
+		Dest += NumToCopy;
+		Num -= NumToCopy;
+		Offset += NumToCopy;
+	}
+}
+
+int64 FSaveGameStreamReader::TotalSize()
+{
+	return bStreaming ? FileHeader.UncompressedSize : Bytes.Num();
+}
+
+const TArray<uint8>* FSaveGameStreamReader::GetBlock(int32 BlockIdx)
+{
+	const int32 CachedIdx = Blocks.IndexOfByPredicate([BlockIdx](const FBlock& Block) { return Block.Index == BlockIdx; });
+	if (CachedIdx != INDEX_NONE)
+	{
+		if (CachedIdx != Blocks.Num() - 1)
+		{
+			// Keep the most recently used block last
+			FBlock Block = MoveTemp(Blocks[CachedIdx]);
+			Blocks.RemoveAt(CachedIdx, 1, EAllowShrinking::No);
+			Blocks.Add(MoveTemp(Block));
+		}
+
+		return &Blocks.Last().Data;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_DecompressBlock);
+
+	if (!BlockOffsets.IsValidIndex(BlockIdx))
+	{
+		return nullptr;
+	}
+
+	// Reuse the least recently used block's memory
+	FBlock Block;
+	if (Blocks.Num() >= MaxBlocks)
+	{
+		Block = MoveTemp(Blocks[0]);
+		Blocks.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	const int64 BlockStart = static_cast<int64>(BlockIdx) * FileHeader.BlockSize;
+	const TConstArrayView<uint8> CompressedBlock = CompressedBlocks.Slice(static_cast<int32>(BlockOffsets[BlockIdx]), FileHeader.BlockSizes[BlockIdx]);
+
+	Block.Index = BlockIdx;
+	Block.Data.SetNumUninitialized(static_cast<int32>(FMath::Min<int64>(FileHeader.BlockSize, FileHeader.UncompressedSize - BlockStart)), EAllowShrinking::No);
+
+	// Same as FSaveGameCompression::DecompressBlocks, a block that's the same size as its data wasn't compressed
+	if (CompressedBlock.Num() == Block.Data.Num())
+	{
+		FMemory::Memcpy(Block.Data.GetData(), CompressedBlock.GetData(), Block.Data.Num());
+	}
+	else if (!FSaveGameCompression::Decompress(FileHeader.Codec, CompressedBlock, Block.Data))
+	{
+		return nullptr;
+	}
+
+	if (BlockOffsets.IsValidIndex(BlockIdx + 1))
+	{
+		// Most reads move forward through the save, so have the OS start paging in the next block
+		const int64 CompressedStart = CompressedBlocks.GetData() - MappedRegion->GetMappedPtr();
+		MappedRegion->PreloadHint(CompressedStart + BlockOffsets[BlockIdx + 1], FileHeader.BlockSizes[BlockIdx + 1]);
+	}
+
+	Blocks.Add(MoveTemp(Block));
+	return &Blocks.Last().Data;
+}
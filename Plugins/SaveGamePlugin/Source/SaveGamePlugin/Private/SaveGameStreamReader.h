@@ -0,0 +1,77 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "SaveGameFileHeader.h"
+#include "Async/MappedFileHandle.h"
+#include "Serialization/Archive.h"
+
+/**
+ * A memory reader that can instead read from a memory mapped save file, decompressing each block as it's reached,
+ * rather than needing the whole save to be decompressed up front. Until streaming begins (or if it never does), this
+ * behaves just like an FMemoryReader.
+ *
+ * Only a window of the most recently read blocks is kept decompressed, and the block after the one being read is
+ * hinted to the OS to be paged in, as reads mostly move forward through the save.
+ */
+class FSaveGameStreamReader final : public FArchive
+{
+public:
+	explicit FSaveGameStreamReader(const TArray<uint8>& InBytes);
+
+	/**
+	 * Opens and maps a save file, so that it can be streamed from.
+	 *
+	 * @param Filename The save file to map
+	 * @param OutFileHeader The save's file header and block table
+	 * @return false if the file couldn't be mapped (i.e. it doesn't exist, or the platform can't map files)
+	 */
+	bool OpenMapped(const FString& Filename, FSaveGameFileHeader& OutFileHeader);
+
+	/** Whether OpenMapped has mapped a file */
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+	/** The size of the mapped file, zero if there isn't one */
+	int64 GetMappedSize() const { return MappedRegion ? MappedRegion->GetMappedSize() : 0; }
+
+	/**
+	 * Starts reading from the mapped file's blocks, rather than the bytes that we were constructed with.
+	 * @param InMaxBlocks The number of decompressed blocks to keep in memory
+	 */
+	void BeginStreaming(int32 InMaxBlocks);
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual void Seek(int64 InPos) override { Offset = InPos; }
+	virtual int64 Tell() override { return Offset; }
+	virtual int64 TotalSize() override;
+	virtual FString GetArchiveName() const override { return TEXT("FSaveGameStreamReader"); }
+	//~ End FArchive Interface
+
+private:
+	/** Returns a decompressed block, decompressing it (and evicting the least recently used block) if needed */
+	const TArray<uint8>* GetBlock(int32 BlockIdx);
+
+	const TArray<uint8>& Bytes;
+	int64 Offset = 0;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	FSaveGameFileHeader FileHeader;
+	TConstArrayView<uint8> CompressedBlocks;
+
+	/** Where each block starts in CompressedBlocks */
+	TArray<int64> BlockOffsets;
+
+	struct FBlock
+	{
+		int32 Index = INDEX_NONE;
+		TArray<uint8> Data;
+	};
+
+	/** The decompressed blocks, most recently used last */
+	TArray<FBlock, TInlineAllocator<4>> Blocks;
+	int32 MaxBlocks = 0;
+	bool bStreaming = false;
+};
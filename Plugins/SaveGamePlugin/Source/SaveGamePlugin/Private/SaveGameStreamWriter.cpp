@@ -0,0 +1,165 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameStreamWriter.h"
+
+#include "SaveGameCompression.h"
+#include "SaveGamePhaseStats.h"
+
+FSaveGameStreamWriter::FSaveGameStreamWriter(TArray<uint8>& InBytes)
+	: Bytes(InBytes)
+{
+	SetIsSaving(true);
+}
+
+void FSaveGameStreamWriter::BeginStreaming(int32 InBlockSize, TFunction<void(TConstArrayView<uint8>)>&& InBlockSink)
+{
+	check(InBlockSize > 0 && !BlockSink);
+
+	BlockSize = InBlockSize;
+	BlockSink = MoveTemp(InBlockSink);
+
+	StreamBlocks();
+}
+
+void FSaveGameStreamWriter::EndStreaming()
+{
+	check(BlockSink && Pins.IsEmpty());
+
+	// Everything that's left, the last block may be a partial block
+	for (int32 BlockOffset = 0; BlockOffset < Bytes.Num(); BlockOffset += BlockSize)
+	{
+		BlockSink(MakeArrayView(Bytes).Mid(BlockOffset, BlockSize));
+	}
+
+	StreamedSize += Bytes.Num();
+	Bytes.Empty();
+
+	BlockSink = nullptr;
+}
+
+void FSaveGameStreamWriter::Pin(int64 Position)
+{
+	check(Position >= StreamedSize && (Pins.IsEmpty() || Position >= Pins.Last()));
+	Pins.Add(Position);
+}
+
+void FSaveGameStreamWriter::Unpin()
+{
+	Pins.Pop(EAllowShrinking::No);
+
+	if (BlockSink)
+	{
+		StreamBlocks();
+	}
+}
+
+void FSaveGameStreamWriter::Serialize(void* Data, int64 Num)
+{
+	const int64 LocalOffset = Offset - StreamedSize;
+	const int64 NumBytesToAdd = LocalOffset + Num - Bytes.Num();
+
+	if (NumBytesToAdd > 0)
+	{
+		if (Bytes.Num() + NumBytesToAdd >= MAX_int32)
+		{
+			// Same limit as FMemoryWriter, streaming keeps us well below this
+			SetError();
+			return;
+		}
+
+		Bytes.AddUninitialized(static_cast<int32>(NumBytesToAdd));
+	}
+
+	if (Num)
+	{
+		FMemory::Memcpy(Bytes.GetData() + LocalOffset, Data, Num);
+		Offset += Num;
+	}
+
+	if (BlockSink)
+	{
+		StreamBlocks();
+	}
+}
+
+void FSaveGameStreamWriter::Seek(int64 InPos)
+{
+	// Anything that will be sought back to should have been pinned
+	checkf(InPos >= StreamedSize, TEXT("Seeking to %lld, which has already been streamed out"), InPos);
+	Offset = InPos;
+}
+
+void FSaveGameStreamWriter::StreamBlocks()
+{
+	const int64 EndPosition = Pins.IsEmpty() ? Offset : FMath::Min(Offset, Pins[0]);
+	int32 NumStreamed = 0;
+
+	while (EndPosition - StreamedSize - NumStreamed >= BlockSize && Bytes.Num() - NumStreamed >= BlockSize)
+	{
+		BlockSink(MakeArrayView(Bytes).Mid(NumStreamed, BlockSize));
+		NumStreamed += BlockSize;
+	}
+
+	if (NumStreamed > 0)
+	{
+		Bytes.RemoveAt(0, NumStreamed, EAllowShrinking::No);
+		StreamedSize += NumStreamed;
+	}
+}
+
+FSaveGameBlockWriter::FSaveGameBlockWriter(TUniquePtr<FArchive>&& InFile, const FSaveGameCompressionSettings& InSettings, int32 InMaxPendingBlocks)
+	: File(MoveTemp(InFile))
+	, Settings(InSettings)
+	, MaxPendingBlocks(FMath::Max(1, InMaxPendingBlocks))
+{
+}
+
+FSaveGameBlockWriter::~FSaveGameBlockWriter()
+{
+	// The tasks reference us
+	Flush();
+}
+
+void FSaveGameBlockWriter::AddBlock(TConstArrayView<uint8> Block)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SaveGame_AddBlock);
+
+	// Bound how much memory we hold on to, by waiting for the oldest block to be written
+	while (PendingBlocks.Num() >= MaxPendingBlocks)
+	{
+		PendingBlocks[0].Wait();
+		PendingBlocks.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	TSharedRef<TArray<uint8>> CompressedBlock = MakeShared<TArray<uint8>>();
+
+	const UE::Tasks::FTask CompressTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, CompressedBlock, UncompressedBlock = TArray<uint8>(Block)]
+	{
+		LLM_SCOPE_BYTAG(SaveGame);
+		FSaveGameCompression::CompressBlock(Settings, UncompressedBlock, *CompressedBlock);
+	});
+
+	// Blocks land in the file in order, so each is only written once the block before it has been
+	TArray<UE::Tasks::FTask, TInlineAllocator<2>> WritePrerequisites = { CompressTask };
+	if (!PendingBlocks.IsEmpty())
+	{
+		WritePrerequisites.Add(PendingBlocks.Last());
+	}
+
+	PendingBlocks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, CompressedBlock]
+	{
+		LLM_SCOPE_BYTAG(SaveGame);
+		File->Serialize(CompressedBlock->GetData(), CompressedBlock->Num());
+		BlockSizes.Add(CompressedBlock->Num());
+	}, WritePrerequisites));
+}
+
+void FSaveGameBlockWriter::Flush()
+{
+	if (!PendingBlocks.IsEmpty())
+	{
+		// Blocks are written in order, so the last block is the last to finish
+		PendingBlocks.Last().Wait();
+		PendingBlocks.Reset();
+	}
+}
@@ -0,0 +1,98 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "SaveGameSettings.h"
+#include "Serialization/Archive.h"
+#include "Tasks/Task.h"
+
+/**
+ * A memory writer that can stream its data out in fixed-size blocks as it's written, rather than holding on to all
+ * of it. Until streaming begins (or if it never does), this behaves just like an FMemoryWriter.
+ *
+ * Once streaming, a block is handed off as soon as nothing can write to it again. As serialization only ever seeks
+ * back to patch something that it wrote earlier (i.e. the size of an actor's record), the start of anything that will
+ * be patched must be pinned, which holds back the blocks from that point on.
+ *
+ * Positions (Tell, Seek and pins) are always of the whole stream, the underlying bytes only hold what hasn't been
+ * handed off yet.
+ */
+class FSaveGameStreamWriter final : public FArchive
+{
+public:
+	explicit FSaveGameStreamWriter(TArray<uint8>& InBytes);
+
+	/**
+	 * Starts handing off each block once it can no longer be written to.
+	 * @param InBlockSize The size of each block, only the last block (handed off by EndStreaming) may be smaller
+	 * @param InBlockSink Receives each block, in order
+	 */
+	void BeginStreaming(int32 InBlockSize, TFunction<void(TConstArrayView<uint8>)>&& InBlockSink);
+
+	/** Hands off everything that hasn't been yet, nothing else can be written afterwards */
+	void EndStreaming();
+
+	/** Holds back the block at this position (and any after it) from being handed off, until it's unpinned */
+	void Pin(int64 Position);
+	void Unpin();
+
+	/** How much of the stream has been handed off */
+	int64 GetStreamedSize() const { return StreamedSize; }
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual void Seek(int64 InPos) override;
+	virtual int64 Tell() override { return Offset; }
+	virtual int64 TotalSize() override { return StreamedSize + Bytes.Num(); }
+	virtual FString GetArchiveName() const override { return TEXT("FSaveGameStreamWriter"); }
+	//~ End FArchive Interface
+
+private:
+	/** Hands off any blocks that are before the current position and any pins */
+	void StreamBlocks();
+
+	TArray<uint8>& Bytes;
+	int64 Offset = 0;
+
+	int64 StreamedSize = 0;
+	int32 BlockSize = 0;
+	TFunction<void(TConstArrayView<uint8>)> BlockSink;
+
+	/** Pinned positions, which can only increase as they're nested */
+	TArray<int64, TInlineAllocator<4>> Pins;
+};
+
+/**
+ * Compresses blocks of save data as they're produced, and writes them to a file in order, on worker threads.
+ * At most MaxPendingBlocks are held in memory at once, adding a block past that waits for the oldest to be written.
+ *
+ * Blocks are compressed the same way as FSaveGameCompression::CompressBlocks.
+ */
+class FSaveGameBlockWriter
+{
+public:
+	FSaveGameBlockWriter(TUniquePtr<FArchive>&& InFile, const FSaveGameCompressionSettings& InSettings, int32 InMaxPendingBlocks);
+	~FSaveGameBlockWriter();
+
+	/** Starts compressing a block, it'll be written after any blocks that were added before it */
+	void AddBlock(TConstArrayView<uint8> Block);
+
+	/** Waits for every block to be written, the file can then be written to directly */
+	void Flush();
+
+	/** The compressed size of each block that has been written */
+	const TArray<int32>& GetBlockSizes() const { return BlockSizes; }
+
+	FArchive& GetFile() const { return *File; }
+
+private:
+	TUniquePtr<FArchive> File;
+	FSaveGameCompressionSettings Settings;
+	int32 MaxPendingBlocks;
+
+	/** The write task of each block that's still in memory, oldest first */
+	TArray<UE::Tasks::FTask> PendingBlocks;
+
+	/** Only written to by the write tasks, which run one after the other */
+	TArray<int32> BlockSizes;
+};
@@ -2,21 +2,30 @@
 
 #include "SaveGameSubsystem.h"
 
+#include "SaveGameActorRegistry.h"
 #include "SaveGameFunctionLibrary.h"
+#include "SaveGameIncrementalCache.h"
 #include "SaveGameObject.h"
+#include "SaveGamePlugin.h"
 #include "SaveGameSerializer.h"
+#include "SaveGameSettings.h"
 
 #include "EngineUtils.h"
+#include "Engine/GameInstance.h"
 
 void USaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	ActorRegistry = MakeShared<FSaveGameActorRegistry>();
+	IncrementalCache = MakeShared<FSaveGameIncrementalCache>();
+	
 	FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &ThisClass::OnWorldInitialized);
 	FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &ThisClass::OnActorsInitialized);
 	FWorldDelegates::OnWorldCleanup.AddUObject(this, &ThisClass::OnWorldCleanup);
+	
+	FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelAdded);
+	FWorldDelegates::PreLevelRemovedFromWorld.AddUObject(this, &ThisClass::OnLevelRemoved);
 
-	// This example doesn't handle streaming levels, but if we did, we'd use a combination of
-	// FWorldDelegates::LevelAddedToWorld and FWorldDelegates::PreLevelRemovedFromWorld
-	// In these, we'd store the current state of actors within that level
+	SetPlaySeconds(0.0);
 
 	OnWorldInitialized(GetWorld(), UWorld::InitializationValues());
 }
@@ -29,27 +38,137 @@ void USaveGameSubsystem::Deinitialize()
 	
 	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
 	FWorldDelegates::PreLevelRemovedFromWorld.RemoveAll(this);
+
+	// Make sure that any in-flight saves make it to disk
+	WaitForAsyncSaves();
 }
 
-bool USaveGameSubsystem::Save()
+bool USaveGameSubsystem::Save(ESaveGameType SaveType, const FString& SlotName)
 {
+	if (!IsValidSlotName(SlotName))
+	{
+		return false;
+	}
+
+	CurrentSlot = SlotName;
+
+	// Async saves may be writing to the same slot, so this one needs to land after them
+	WaitForAsyncSaves();
+	
+	// Saves are binary only, USaveGameDumpCommandlet can write any save out as text for debugging
 	TSaveGameSerializer<false> BinarySerializer(this);
-	bool bSuccess = BinarySerializer.Save();
+	BinarySerializer.SetSaveName(SlotName);
+	return BinarySerializer.Save(SaveType);
+}
+
+bool USaveGameSubsystem::SaveAsync(ESaveGameType SaveType, const FOnSaveGameCompleted& OnCompleted, const FString& SlotName)
+{
+	if (!IsValidSlotName(SlotName) || NumPendingSaves >= GetDefault<USaveGameSettings>()->GetMaxPendingAsyncSaves())
+	{
+		return false;
+	}
 
-#if !UE_BUILD_SHIPPING && WITH_TEXT_ARCHIVE_SUPPORT
-	// This is for debug purposes only, we want to use binary serialization for smallest file sizes
-	TSaveGameSerializer<false, true> TextSerializer(this);
-	bSuccess &= TextSerializer.Save();
-#endif
+	++NumPendingSaves;
+	CurrentSlot = SlotName;
 	
-	return bSuccess;
+	const TSharedRef<TSaveGameSerializer<false>> BinarySerializer = MakeShared<TSaveGameSerializer<false>>(this);
+	BinarySerializer->SetSaveName(SlotName);
+	LastSaveTask = BinarySerializer->SaveAsync(SaveType, LastSaveTask, [WeakThis = TWeakObjectPtr<ThisClass>(this), OnCompleted](bool bSuccess)
+	{
+		if (USaveGameSubsystem* This = WeakThis.Get())
+		{
+			This->OnSaveCompleted(bSuccess, OnCompleted);
+		}
+	});
+
+	if (!FSaveGameFileHeader::AreSlotsFiles())
+	{
+		PendingWrites.Emplace(BinarySerializer, LastSaveTask);
+	}
+
+	return true;
 }
 
-bool USaveGameSubsystem::Load()
+void USaveGameSubsystem::WritePendingSaves(bool bWait)
 {
+	while (PendingWrites.Num() > 0)
+	{
+		const UE::Tasks::FTask& SaveTask = PendingWrites[0].Value;
+		if (bWait)
+		{
+			SaveTask.Wait();
+		}
+		else if (!SaveTask.IsCompleted())
+		{
+			// Later saves have to wait for this one, so that they land in order
+			break;
+		}
+
+		// Removed before writing, as the save's OnCompleted may save again
+		const TSharedPtr<FSaveGameSerializer, ESPMode::ThreadSafe> Serializer = PendingWrites[0].Key;
+		PendingWrites.RemoveAt(0);
+		Serializer->WriteAsyncSave();
+	}
+}
+
+void USaveGameSubsystem::WaitForAsyncSaves()
+{
+	// Any saves that the game thread writes are only waited on for their compression, then written here
+	LastSaveTask.Wait();
+	WritePendingSaves(true);
+}
+
+bool USaveGameSubsystem::IsSavingSaveGame() const
+{
+	return NumPendingSaves > 0;
+}
+
+void USaveGameSubsystem::MarkSaveDirty(AActor* Actor)
+{
+	if (IsValid(Actor))
+	{
+		IncrementalCache->Invalidate(Actor);
+	}
+}
+
+bool USaveGameSubsystem::Load(const FString& SlotName)
+{
+	if (IsLoadingSaveGame() || !IsValidSlotName(SlotName))
+	{
+		return false;
+	}
+	
 	const TSharedRef<TSaveGameSerializer<true>> BinarySerializer = MakeShared<TSaveGameSerializer<true>>(this); 
+	BinarySerializer->SetSaveName(SlotName);
 	CurrentSerializer = BinarySerializer.ToSharedPtr();
-	return BinarySerializer->Load();
+
+	if (!BinarySerializer->Load())
+	{
+		CurrentSerializer = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+bool USaveGameSubsystem::LoadAsync(const FString& SlotName)
+{
+	if (IsLoadingSaveGame() || !IsValidSlotName(SlotName))
+	{
+		return false;
+	}
+	
+	const TSharedRef<TSaveGameSerializer<true>> BinarySerializer = MakeShared<TSaveGameSerializer<true>>(this); 
+	BinarySerializer->SetSaveName(SlotName);
+	CurrentSerializer = BinarySerializer.ToSharedPtr();
+
+	if (!BinarySerializer->LoadAsync())
+	{
+		CurrentSerializer = nullptr;
+		return false;
+	}
+
+	return true;
 }
 
 bool USaveGameSubsystem::IsLoadingSaveGame() const
@@ -57,6 +176,33 @@ bool USaveGameSubsystem::IsLoadingSaveGame() const
 	return CurrentSerializer.IsValid();
 }
 
+void USaveGameSubsystem::SetSlotUserData(const FString& Key, const FString& Value)
+{
+	SlotUserData.Add(Key, Value);
+}
+
+void USaveGameSubsystem::RemoveSlotUserData(const FString& Key)
+{
+	SlotUserData.Remove(Key);
+}
+
+double USaveGameSubsystem::GetPlaySeconds() const
+{
+	return PlaySecondsOffset + (FPlatformTime::Seconds() - PlayStartTime);
+}
+
+void USaveGameSubsystem::SetPlaySeconds(double PlaySeconds)
+{
+	PlaySecondsOffset = PlaySeconds;
+	PlayStartTime = FPlatformTime::Seconds();
+}
+
+bool USaveGameSubsystem::IsValidSlotName(const FString& SlotName)
+{
+	// Slots are files on most platforms, so they can't be paths or have characters that aren't allowed in file names
+	return !SlotName.IsEmpty() && FPaths::MakeValidFileName(SlotName) == SlotName;
+}
+
 void USaveGameSubsystem::OnWorldInitialized(UWorld* World, const UWorld::InitializationValues)
 {
 	if (!IsValid(World) || GetWorld() != World)
@@ -77,11 +223,7 @@ void USaveGameSubsystem::OnActorsInitialized(const FActorsInitializedParams& Par
 	
 	for (TActorIterator<AActor> It(Params.World); It; ++It)
 	{
-		AActor* Actor = *It;
-		if (IsValid(Actor) && Actor->Implements<USaveGameObject>())
-		{
-			SaveGameActors.Add(Actor);
-		}
+		ActorRegistry->Add(*It);
 	}
 }
 
@@ -92,21 +234,125 @@ void USaveGameSubsystem::OnWorldCleanup(UWorld* World, bool, bool)
 		return;
 	}
 	
-	SaveGameActors.Reset();
+	ActorRegistry->Reset();
 	DestroyedLevelActors.Reset();
+	LevelChunks.Reset();
+	PendingLevelChunks.Reset();
+	IncrementalCache->Reset();
 }
 
-void USaveGameSubsystem::OnActorPreSpawn(AActor* Actor)
+void USaveGameSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
 {
-	if (IsValid(Actor) && Actor->Implements<USaveGameObject>())
+	if (!IsValid(Level) || !IsValid(World) || GetWorld() != World || Level == World->PersistentLevel)
+	{
+		return;
+	}
+
+	// Level actors aren't spawned, so they need to be picked up here
+	for (AActor* Actor : Level->Actors)
 	{
-		SaveGameActors.Add(Actor);
+		ActorRegistry->Add(Actor);
+	}
+
+	// If we're in the middle of loading, the chunk will be loaded once the load has completed
+	if (!IsLoadingSaveGame())
+	{
+		LoadLevelChunk(Level);
 	}
 }
 
+void USaveGameSubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (!IsValid(Level) || !IsValid(World) || GetWorld() != World || Level == World->PersistentLevel)
+	{
+		return;
+	}
+
+	const FName LevelName = GetLevelChunkName(Level->GetPackage()->GetName());
+	
+	TArray<AActor*> LevelActors;
+	TArray<FSoftObjectPath> LevelDestroyedActors;
+
+	// Hand the level's actors over to its chunk, the subsystem forgets about them until the level is loaded again
+	ActorRegistry->RemoveLevelActors(Level, LevelActors);
+
+	for (const AActor* Actor : LevelActors)
+	{
+		IncrementalCache->Invalidate(Actor);
+	}
+
+	for (auto It = DestroyedLevelActors.CreateIterator(); It; ++It)
+	{
+		if (GetLevelChunkName(It->GetLongPackageName()) == LevelName)
+		{
+			LevelDestroyedActors.Add(*It);
+			It.RemoveCurrent();
+		}
+	}
+
+	// A chunk that's still waiting on its classes was never loaded into the level's actors, so it's kept as is
+	TSharedPtr<FSaveGameSerializer, ESPMode::ThreadSafe> PendingChunk;
+	if (PendingLevelChunks.RemoveAndCopyValue(LevelName, PendingChunk))
+	{
+		LevelChunks.Add(LevelName, StaticCastSharedPtr<TSaveGameSerializer<true>>(PendingChunk)->CancelLoadLevel());
+		return;
+	}
+
+	TSaveGameSerializer<false> LevelSerializer(this, Level);
+	LevelSerializer.SaveLevel(MoveTemp(LevelActors), MoveTemp(LevelDestroyedActors), LevelChunks.FindOrAdd(LevelName));
+}
+
+void USaveGameSubsystem::LoadLevelChunk(ULevel* Level)
+{
+	const FName LevelName = GetLevelChunkName(Level->GetPackage()->GetName());
+	
+	TArray<uint8> LevelChunk;
+	if (!LevelChunks.RemoveAndCopyValue(LevelName, LevelChunk))
+	{
+		return;
+	}
+
+	const TSharedRef<TSaveGameSerializer<true>> LevelSerializer = MakeShared<TSaveGameSerializer<true>>(this, Level);
+	PendingLevelChunks.Add(LevelName, LevelSerializer);
+	
+	LevelSerializer->LoadLevelAsync(MoveTemp(LevelChunk), [WeakThis = TWeakObjectPtr<ThisClass>(this), LevelName](bool bSuccess)
+	{
+		if (USaveGameSubsystem* This = WeakThis.Get())
+		{
+			This->PendingLevelChunks.Remove(LevelName);
+		}
+		
+		if (!bSuccess)
+		{
+			// The chunk isn't kept, it would only fail again. The level's live actors replace it when it's next saved.
+			UE_LOG(LogSaveGame, Warning, TEXT("Failed to load the saved state of level '%s', its chunk may be corrupt or from an unsupported version"), *LevelName.ToString());
+		}
+	});
+}
+
+FName USaveGameSubsystem::GetLevelChunkName(const FString& PackageName)
+{
+	return FName(*UWorld::RemovePIEPrefix(PackageName));
+}
+
+void USaveGameSubsystem::OnActorPreSpawn(AActor* Actor)
+{
+	ActorRegistry->Add(Actor);
+}
+
 void USaveGameSubsystem::OnActorDestroyed(AActor* Actor)
 {
-	SaveGameActors.Remove(Actor);
+	// Actors of a level that's being unloaded have already been handed over to the level's chunk
+	if (Actor->GetLevel() && Actor->GetLevel()->bIsBeingRemoved)
+	{
+		return;
+	}
+	
+	// Only saved actors can be in the incremental cache
+	if (ActorRegistry->Remove(Actor))
+	{
+		IncrementalCache->Invalidate(Actor);
+	}
 
 	if (USaveGameFunctionLibrary::WasObjectLoaded(Actor))
 	{
@@ -114,7 +360,58 @@ void USaveGameSubsystem::OnActorDestroyed(AActor* Actor)
 	}
 }
 
-void USaveGameSubsystem::OnLoadCompleted()
+void USaveGameSubsystem::OnSaveCompleted(bool bSuccess, const FOnSaveGameCompleted& OnCompleted)
+{
+	--NumPendingSaves;
+	OnCompleted.ExecuteIfBound(bSuccess);
+}
+
+void USaveGameSubsystem::OnLoadCompleted(bool bSuccess)
 {
 	CurrentSerializer = nullptr;
+
+	// Loading may have changed actor data that isn't tracked, so start afresh
+	IncrementalCache->Reset();
+
+	// Streaming levels that were loaded alongside the map have been waiting on us
+	if (const UWorld* World = GetWorld())
+	{
+		for (ULevel* Level : World->GetLevels())
+		{
+			if (Level != World->PersistentLevel && Level->bIsVisible)
+			{
+				LoadLevelChunk(Level);
+			}
+		}
+	}
+
+	OnSaveGameLoaded.Broadcast(bSuccess);
 }
+
+static void PrintStats(UWorld* World)
+{
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	const USaveGameSubsystem* SaveGameSubsystem = GameInstance ? GameInstance->GetSubsystem<USaveGameSubsystem>() : nullptr;
+
+	if (!SaveGameSubsystem)
+	{
+		UE_LOG(LogSaveGame, Warning, TEXT("SaveGame.Stats: No save game subsystem in this world"));
+		return;
+	}
+
+	const FSaveGameStats& Stats = SaveGameSubsystem->GetStats();
+
+	UE_LOG(LogSaveGame, Display, TEXT("Saves: %d, last %.2fms (%.2fms on the game thread), peak %.2fms"), Stats.NumSaves,
+		Stats.LastSaveSeconds * 1000.f, Stats.LastSaveGameThreadSeconds * 1000.f, Stats.PeakSaveSeconds * 1000.f);
+	UE_LOG(LogSaveGame, Display, TEXT("       %d actors, %lld bytes serialized, %lld bytes written (%.3f)"), Stats.LastSaveActors,
+		Stats.LastSaveBytesSerialized, Stats.LastSaveBytesWritten, Stats.LastCompressionRatio);
+	UE_LOG(LogSaveGame, Display, TEXT("Loads: %d, last %.2fms, peak %.2fms"), Stats.NumLoads,
+		Stats.LastLoadSeconds * 1000.f, Stats.PeakLoadSeconds * 1000.f);
+	UE_LOG(LogSaveGame, Display, TEXT("       %d actors, %lld bytes read, %lld bytes serialized"), Stats.LastLoadActors,
+		Stats.LastLoadBytesRead, Stats.LastLoadBytesSerialized);
+}
+
+static FAutoConsoleCommandWithWorld PrintStatsCommand(
+	TEXT("SaveGame.Stats"),
+	TEXT("Prints how long the most recent saves and loads took, and how big they were"),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&PrintStats));
@@ -0,0 +1,733 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#include "SaveGameBenchmarkActor.h"
+#include "SaveGameBenchmarkCommandlet.h"
+#include "SaveGameCompression.h"
+#include "SaveGameFileHeader.h"
+#include "SaveGameFunctionLibrary.h"
+#include "SaveGameIncrementalCache.h"
+#include "SaveGameProxyArchive.h"
+#include "SaveGameSerializer.h"
+#include "SaveGameStreamReader.h"
+#include "SaveGameStreamWriter.h"
+#include "SaveGameSubsystem.h"
+
+#include "EngineUtils.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Algo/Count.h"
+#include "Engine/GameInstance.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/Formatters/BinaryArchiveFormatter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#define SAVEGAME_TEST_FLAGS (EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+#define SAVEGAME_TEST_SAVE_NAME TEXT("SaveGameTests")
+
+namespace SaveGameTests
+{
+	/** A standalone game instance, which gives us a world with a save game subsystem, without needing a map */
+	struct FTestWorld
+	{
+		FTestWorld()
+		{
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+
+			World = GameInstance->GetWorld();
+			Subsystem = GameInstance->GetSubsystem<USaveGameSubsystem>();
+			check(World && Subsystem);
+		}
+
+		~FTestWorld()
+		{
+			if (ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem())
+			{
+				SaveSystem->DeleteGame(false, SAVEGAME_TEST_SAVE_NAME, 0);
+			}
+
+			GameInstance->Shutdown();
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			GameInstance->RemoveFromRoot();
+		}
+
+		/** Spawns benchmark actors of every kind, some of which reference each other */
+		TArray<ASaveGameBenchmarkActor*> SpawnActors(FRandomStream& Random)
+		{
+			const TSubclassOf<ASaveGameBenchmarkActor> ActorClasses[] = { ASaveGameBenchmarkActor::StaticClass(), ASaveGameBenchmarkParallelActor::StaticClass(), ASaveGameBenchmarkSpawnActor::StaticClass() };
+
+			TArray<ASaveGameBenchmarkActor*> Actors;
+			for (int32 ActorIdx = 0; ActorIdx < 12; ++ActorIdx)
+			{
+				ASaveGameBenchmarkActor* Actor = World->SpawnActor<ASaveGameBenchmarkActor>(ActorClasses[ActorIdx % UE_ARRAY_COUNT(ActorClasses)]);
+				Actor->Randomize(Random, 32 + ActorIdx, ActorIdx % 2 == 1 ? Actors[Random.RandHelper(Actors.Num())] : nullptr);
+
+				if (ASaveGameBenchmarkSpawnActor* SpawnActor = Cast<ASaveGameBenchmarkSpawnActor>(Actor))
+				{
+					SpawnActor->SpawnID = FGuid::NewGuid();
+				}
+
+				Actors.Add(Actor);
+			}
+
+			return Actors;
+		}
+
+		/** Destroys the actors that a load will spawn again, leaving the actors that are mapped by SpawnID */
+		void DestroyActors()
+		{
+			for (TActorIterator<ASaveGameBenchmarkActor> It(World); It; ++It)
+			{
+				if (!It->IsA<ASaveGameBenchmarkSpawnActor>())
+				{
+					It->Destroy();
+				}
+			}
+
+			// Free up the actors' names, as they're spawned again with the same names
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		bool Save()
+		{
+			TSaveGameSerializer<false> Serializer(Subsystem);
+			Serializer.SetSaveName(SAVEGAME_TEST_SAVE_NAME);
+			return Serializer.Save();
+		}
+
+		bool Load()
+		{
+			TSaveGameSerializer<true> Serializer(Subsystem);
+			Serializer.SetSaveName(SAVEGAME_TEST_SAVE_NAME);
+			return Serializer.LoadWithoutTravel();
+		}
+
+		UGameInstance* GameInstance = nullptr;
+		UWorld* World = nullptr;
+		USaveGameSubsystem* Subsystem = nullptr;
+	};
+
+	/** What a benchmark actor saves, so that it can be compared after the actor has been destroyed and loaded again */
+	struct FActorState
+	{
+		FTransform Transform;
+		int32 Health = 0;
+		FVector Velocity = FVector::ZeroVector;
+		FName State;
+		TArray<uint8> Payload;
+		FString TargetName;
+		int64 Counter = 0;
+	};
+
+	/** Each benchmark actor's state, by the actor's name */
+	TMap<FString, FActorState> CaptureActors(UWorld* World)
+	{
+		TMap<FString, FActorState> States;
+
+		for (TActorIterator<ASaveGameBenchmarkActor> It(World); It; ++It)
+		{
+			FActorState& State = States.Add(It->GetName());
+			State.Transform = It->GetActorTransform();
+			State.Health = It->Health;
+			State.Velocity = It->Velocity;
+			State.State = It->State;
+			State.Payload = It->Payload;
+			State.TargetName = It->Target ? It->Target->GetName() : FString();
+			State.Counter = It->Counter;
+		}
+
+		return States;
+	}
+
+	void TestActorsEqual(FAutomationTestBase& Test, const TMap<FString, FActorState>& Expected, const TMap<FString, FActorState>& Actual)
+	{
+		Test.TestEqual(TEXT("Number of actors"), Actual.Num(), Expected.Num());
+
+		for (const TPair<FString, FActorState>& ExpectedActor : Expected)
+		{
+			const FActorState* ActualState = Actual.Find(ExpectedActor.Key);
+			if (!Test.TestNotNull(*FString::Printf(TEXT("%s was loaded"), *ExpectedActor.Key), ActualState))
+			{
+				continue;
+			}
+
+			const FActorState& ExpectedState = ExpectedActor.Value;
+			Test.TestTrue(*FString::Printf(TEXT("%s transform"), *ExpectedActor.Key), ActualState->Transform.Equals(ExpectedState.Transform));
+			Test.TestEqual(*FString::Printf(TEXT("%s Health"), *ExpectedActor.Key), ActualState->Health, ExpectedState.Health);
+			Test.TestEqual(*FString::Printf(TEXT("%s Velocity"), *ExpectedActor.Key), ActualState->Velocity, ExpectedState.Velocity);
+			Test.TestEqual(*FString::Printf(TEXT("%s State"), *ExpectedActor.Key), ActualState->State, ExpectedState.State);
+			Test.TestTrue(*FString::Printf(TEXT("%s Payload"), *ExpectedActor.Key), ActualState->Payload == ExpectedState.Payload);
+			Test.TestEqual(*FString::Printf(TEXT("%s Target"), *ExpectedActor.Key), ActualState->TargetName, ExpectedState.TargetName);
+			Test.TestEqual(*FString::Printf(TEXT("%s Counter"), *ExpectedActor.Key), ActualState->Counter, ExpectedState.Counter);
+		}
+	}
+
+	/** Overrides one of USaveGameSettings' bools for as long as it's in scope */
+	struct FScopedSetting
+	{
+		FScopedSetting(FName PropertyName, bool bValue)
+			: Property(FindFProperty<FBoolProperty>(USaveGameSettings::StaticClass(), PropertyName))
+		{
+			check(Property);
+
+			USaveGameSettings* Settings = GetMutableDefault<USaveGameSettings>();
+			bPreviousValue = Property->GetPropertyValue_InContainer(Settings);
+			Property->SetPropertyValue_InContainer(Settings, bValue);
+		}
+
+		~FScopedSetting()
+		{
+			Property->SetPropertyValue_InContainer(GetMutableDefault<USaveGameSettings>(), bPreviousValue);
+		}
+
+	private:
+		FBoolProperty* Property;
+		bool bPreviousValue = false;
+	};
+
+	/** Data that compresses like a save would (see ASaveGameBenchmarkActor::Randomize), with a block of noise that doesn't */
+	TArray<uint8> MakeData(int32 NumBytes, int32 NoiseStart, int32 NoiseBytes)
+	{
+		FRandomStream Random(NumBytes);
+
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(NumBytes);
+
+		for (int32 ByteIdx = 0; ByteIdx < NumBytes; ++ByteIdx)
+		{
+			const bool bNoise = ByteIdx >= NoiseStart && ByteIdx < NoiseStart + NoiseBytes;
+			Data[ByteIdx] = static_cast<uint8>(Random.RandHelper(bNoise ? 256 : 16));
+		}
+
+		return Data;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameTablesTest, "SaveGamePlugin.Tables", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameTablesTest::RunTest(const FString& Parameters)
+{
+	const FName Names[] = { TEXT("Alpha"), TEXT("Beta"), TEXT("Alpha"), NAME_None };
+	const FSoftObjectPath Paths[] = { FSoftObjectPath(TEXT("/Game/Maps/TestMap.TestMap:PersistentLevel.TestActor_0")), FSoftObjectPath(), FSoftObjectPath(TEXT("/Script/Engine.Actor")), FSoftObjectPath(TEXT("/Game/Maps/TestMap.TestMap:PersistentLevel.TestActor_0")) };
+
+	TArray<uint8> Bytes;
+	int64 PathTablePosition = 0;
+	int64 NameTablePosition = 0;
+
+	{
+		FMemoryWriter Writer(Bytes);
+		TSaveGameProxyArchive<false> Archive(Writer);
+
+		for (FName Name : Names)
+		{
+			Archive << Name;
+		}
+
+		for (FSoftObjectPath Path : Paths)
+		{
+			Archive << Path;
+		}
+
+		// Same as a save, path names are added to the name table, so the path table is written first
+		PathTablePosition = Writer.Tell();
+		Archive.SerializePathTable();
+
+		NameTablePosition = Writer.Tell();
+		Archive.SerializeNameTable();
+
+		const FSaveGameArchiveTables& Tables = Archive.GetTables();
+		TestEqual(TEXT("Duplicate names are only stored once"), static_cast<int32>(Algo::Count(Tables.Names, FName(TEXT("Alpha")))), 1);
+		TestEqual(TEXT("Duplicate and null paths aren't stored"), Tables.Paths.Num(), 2);
+	}
+
+	FMemoryReader Reader(Bytes);
+	TSaveGameProxyArchive<true> Archive(Reader);
+
+	// Whereas loading needs the names before the paths
+	Reader.Seek(NameTablePosition);
+	Archive.SerializeNameTable();
+
+	Reader.Seek(PathTablePosition);
+	Archive.SerializePathTable();
+
+	Reader.Seek(0);
+
+	for (const FName ExpectedName : Names)
+	{
+		FName Name;
+		Archive << Name;
+		TestEqual(TEXT("Name"), Name, ExpectedName);
+	}
+
+	for (const FSoftObjectPath& ExpectedPath : Paths)
+	{
+		FSoftObjectPath Path;
+		Archive << Path;
+		TestTrue(TEXT("Path"), Path == ExpectedPath);
+	}
+
+	TestFalse(TEXT("Archive has errors"), Archive.IsError() || Reader.IsError());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameFieldTableTest, "SaveGamePlugin.FieldTable", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameFieldTableTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Trailer = 0x53475346;
+
+	TArray<uint8> Bytes;
+
+	{
+		FMemoryWriter Writer(Bytes);
+
+		{
+			FBinaryArchiveFormatter Formatter(Writer);
+			FStructuredArchive StructuredArchive(Formatter);
+			FStructuredArchive::FRecord Record = StructuredArchive.Open().EnterRecord();
+
+			FSaveGameArchive Archive(Record, nullptr);
+
+			int32 Health = 42;
+			FString Name = TEXT("Test");
+
+			TestTrue(TEXT("Saved Health"), Archive.SerializeField(TEXT("Health"), [&Health](FStructuredArchive::FSlot Slot) { Slot << Health; }));
+			TestTrue(TEXT("Saved Name"), Archive.SerializeField(TEXT("Name"), [&Name](FStructuredArchive::FSlot Slot) { Slot << Name; }));
+			TestFalse(TEXT("Saved Health twice"), Archive.SerializeField(TEXT("Health"), [&Health](FStructuredArchive::FSlot Slot) { Slot << Health; }));
+		}
+
+		// Whatever follows the archive, which loading should land on once the archive is done with
+		int32 TrailerValue = Trailer;
+		Writer << TrailerValue;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	{
+		FBinaryArchiveFormatter Formatter(Reader);
+		FStructuredArchive StructuredArchive(Formatter);
+		FStructuredArchive::FRecord Record = StructuredArchive.Open().EnterRecord();
+
+		FSaveGameArchive Archive(Record, nullptr);
+
+		int32 Health = 0;
+		FString Name;
+
+		// In the opposite order to how they were saved
+		TestTrue(TEXT("Loaded Name"), Archive.SerializeField(TEXT("Name"), [&Name](FStructuredArchive::FSlot Slot) { Slot << Name; }));
+		TestTrue(TEXT("Loaded Health"), Archive.SerializeField(TEXT("Health"), [&Health](FStructuredArchive::FSlot Slot) { Slot << Health; }));
+		TestFalse(TEXT("Loaded a field that wasn't saved"), Archive.SerializeField(TEXT("Missing"), [](FStructuredArchive::FSlot Slot) {}));
+
+		TestEqual(TEXT("Health"), Health, 42);
+		TestEqual(TEXT("Name"), Name, FString(TEXT("Test")));
+	}
+
+	int32 TrailerValue = 0;
+	Reader << TrailerValue;
+
+	TestEqual(TEXT("Loading continues after the field table"), TrailerValue, Trailer);
+	TestFalse(TEXT("Reader has errors"), Reader.IsError());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameCompressionTest, "SaveGamePlugin.Compression", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameCompressionTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 BlockSize = 16 * 1024;
+
+	// The second block is noise, so it's stored as is, and the last block is short
+	const TArray<uint8> Data = SaveGameTests::MakeData(BlockSize * 3 + 1000, BlockSize, BlockSize);
+
+	const ESaveGameCompressionCodec Codecs[] = { ESaveGameCompressionCodec::None, ESaveGameCompressionCodec::Oodle, ESaveGameCompressionCodec::LZ4, ESaveGameCompressionCodec::Zlib, ESaveGameCompressionCodec::Gzip };
+	for (const ESaveGameCompressionCodec Codec : Codecs)
+	{
+		const FString CodecName = StaticEnum<ESaveGameCompressionCodec>()->GetNameStringByValue(static_cast<int64>(Codec));
+
+		TArray<int32> BlockSizes;
+		TArray<uint8> CompressedData;
+		FSaveGameCompression::CompressBlocks(FSaveGameCompressionSettings(Codec, ESaveGameCompressionLevel::Normal), BlockSize, Data, BlockSizes, CompressedData);
+
+		TestEqual(*FString::Printf(TEXT("%s block count"), *CodecName), BlockSizes.Num(), 4);
+
+		int64 TotalBlockSize = 0;
+		for (const int32 CompressedSize : BlockSizes)
+		{
+			TotalBlockSize += CompressedSize;
+		}
+
+		TestEqual(*FString::Printf(TEXT("%s block sizes add up"), *CodecName), TotalBlockSize, static_cast<int64>(CompressedData.Num()));
+
+		if (Codec != ESaveGameCompressionCodec::None)
+		{
+			TestTrue(*FString::Printf(TEXT("%s compressed"), *CodecName), CompressedData.Num() < Data.Num());
+			TestEqual(*FString::Printf(TEXT("%s noise block is stored"), *CodecName), BlockSizes[1], BlockSize);
+		}
+
+		TArray<uint8> DecompressedData;
+		DecompressedData.SetNumZeroed(Data.Num());
+
+		TestTrue(*FString::Printf(TEXT("%s decompressed"), *CodecName), FSaveGameCompression::DecompressBlocks(Codec, BlockSize, BlockSizes, CompressedData, DecompressedData));
+		TestTrue(*FString::Printf(TEXT("%s round trip"), *CodecName), DecompressedData == Data);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameStreamWriterTest, "SaveGamePlugin.StreamWriter", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameStreamWriterTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 BlockSize = 16;
+
+	// Groups of records, each prefixed with its size, which is patched once it's known (like an actor's record)
+	auto WriteRecords = [](FArchive& Ar, FSaveGameStreamWriter* StreamWriter)
+	{
+		auto BeginSize = [&Ar, StreamWriter]()
+		{
+			const int64 SizePosition = Ar.Tell();
+			if (StreamWriter)
+			{
+				StreamWriter->Pin(SizePosition);
+			}
+
+			int32 Size = 0;
+			Ar << Size;
+			return SizePosition;
+		};
+
+		auto EndSize = [&Ar, StreamWriter](int64 SizePosition)
+		{
+			const int64 EndPosition = Ar.Tell();
+			int32 Size = static_cast<int32>(EndPosition - SizePosition - sizeof(int32));
+
+			Ar.Seek(SizePosition);
+			Ar << Size;
+			Ar.Seek(EndPosition);
+
+			if (StreamWriter)
+			{
+				StreamWriter->Unpin();
+			}
+		};
+
+		for (int32 GroupIdx = 0; GroupIdx < 4; ++GroupIdx)
+		{
+			const int64 GroupPosition = BeginSize();
+
+			for (int32 RecordIdx = 0; RecordIdx < 3; ++RecordIdx)
+			{
+				const int64 RecordPosition = BeginSize();
+
+				for (int32 ByteIdx = 0; ByteIdx < GroupIdx * 7 + RecordIdx * 5; ++ByteIdx)
+				{
+					uint8 Byte = static_cast<uint8>(GroupIdx * 31 + RecordIdx * 7 + ByteIdx);
+					Ar << Byte;
+				}
+
+				EndSize(RecordPosition);
+			}
+
+			EndSize(GroupPosition);
+		}
+	};
+
+	TArray<uint8> Expected;
+	{
+		FMemoryWriter Writer(Expected);
+		WriteRecords(Writer, nullptr);
+	}
+
+	TArray<uint8> Bytes;
+	TArray<uint8> Streamed;
+	TArray<int32> StreamedBlockSizes;
+
+	FSaveGameStreamWriter Writer(Bytes);
+	Writer.BeginStreaming(BlockSize, [&Streamed, &StreamedBlockSizes](TConstArrayView<uint8> Block)
+	{
+		Streamed.Append(Block);
+		StreamedBlockSizes.Add(Block.Num());
+	});
+
+	WriteRecords(Writer, &Writer);
+
+	TestTrue(TEXT("Blocks were streamed while writing"), Writer.GetStreamedSize() > 0);
+	TestTrue(TEXT("Less than a block is held once nothing is pinned"), Bytes.Num() < BlockSize);
+	TestEqual(TEXT("Total size"), Writer.TotalSize(), static_cast<int64>(Expected.Num()));
+
+	Writer.EndStreaming();
+
+	TestFalse(TEXT("Writer has errors"), Writer.IsError());
+	TestTrue(TEXT("Streamed data matches a memory writer's"), Streamed == Expected);
+	TestEqual(TEXT("Streamed size"), Writer.GetStreamedSize(), static_cast<int64>(Expected.Num()));
+
+	for (int32 BlockIdx = 0; BlockIdx < StreamedBlockSizes.Num() - 1; ++BlockIdx)
+	{
+		TestEqual(TEXT("Only the last block is partial"), StreamedBlockSizes[BlockIdx], BlockSize);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameStreamReaderTest, "SaveGamePlugin.StreamReader", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameStreamReaderTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 BlockSize = 4096;
+
+	const TArray<uint8> Data = SaveGameTests::MakeData(BlockSize * 5 + 123, BlockSize * 2, BlockSize);
+	const FSaveGameCompressionSettings Settings(ESaveGameCompressionCodec::Oodle, ESaveGameCompressionLevel::Fast);
+	const FString Filename = FPaths::CreateTempFilename(*FPaths::AutomationTransientDir(), TEXT("SaveGameStreamReader"), TEXT(".sav"));
+
+	// Written the same way as a streamed save, see TSaveGameSerializer::CompressData
+	FSaveGameFileHeader FileHeader(TEXT("/Game/Maps/TestMap"));
+	FileHeader.Codec = Settings.Codec;
+	FileHeader.BlockSize = BlockSize;
+
+	{
+		TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*Filename));
+		if (!TestNotNull(TEXT("Created the save file"), File.Get()))
+		{
+			return false;
+		}
+
+		*File << FileHeader;
+
+		FSaveGameBlockWriter BlockWriter(MoveTemp(File), Settings, 2);
+		for (int32 BlockOffset = 0; BlockOffset < Data.Num(); BlockOffset += BlockSize)
+		{
+			BlockWriter.AddBlock(MakeArrayView(Data).Mid(BlockOffset, BlockSize));
+		}
+
+		BlockWriter.Flush();
+
+		FArchive& BlockFile = BlockWriter.GetFile();
+		FileHeader.UncompressedSize = Data.Num();
+		FileHeader.BlockSizes = BlockWriter.GetBlockSizes();
+		FileHeader.BlockTableOffset = BlockFile.Tell();
+		FileHeader.SerializeBlockTable(BlockFile);
+
+		BlockFile.Seek(0);
+		BlockFile << FileHeader;
+
+		TestTrue(TEXT("Wrote the save file"), BlockFile.Close());
+	}
+
+	ON_SCOPE_EXIT
+	{
+		IFileManager::Get().Delete(*Filename);
+	};
+
+	const TArray<uint8> Bytes;
+	FSaveGameStreamReader Reader(Bytes);
+
+	FSaveGameFileHeader MappedHeader;
+	if (!TestTrue(TEXT("Mapped the save file"), Reader.OpenMapped(Filename, MappedHeader)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Map name"), MappedHeader.MapName, FileHeader.MapName);
+	TestEqual(TEXT("Uncompressed size"), MappedHeader.UncompressedSize, FileHeader.UncompressedSize);
+	TestTrue(TEXT("Block table"), MappedHeader.BlockSizes == FileHeader.BlockSizes);
+	TestEqual(TEXT("Mapped size"), Reader.GetMappedSize(), IFileManager::Get().FileSize(*Filename));
+
+	// Only two blocks are kept decompressed, so reading it all (in reads that span blocks) evicts them
+	Reader.BeginStreaming(2);
+	TestEqual(TEXT("Total size"), Reader.TotalSize(), static_cast<int64>(Data.Num()));
+
+	TArray<uint8> ReadData;
+	ReadData.SetNumZeroed(Data.Num());
+
+	for (int32 Offset = 0; Offset < Data.Num(); Offset += 1000)
+	{
+		Reader.Serialize(ReadData.GetData() + Offset, FMath::Min(1000, Data.Num() - Offset));
+	}
+
+	TestTrue(TEXT("Streamed data matches"), ReadData == Data);
+
+	// Seeking back to a block that has been evicted
+	uint8 FirstBytes[16];
+	Reader.Seek(0);
+	Reader.Serialize(FirstBytes, sizeof(FirstBytes));
+
+	TestTrue(TEXT("Data after seeking back matches"), FMemory::Memcmp(FirstBytes, Data.GetData(), sizeof(FirstBytes)) == 0);
+	TestFalse(TEXT("Reader has errors"), Reader.IsError());
+
+	// Reading past the end is an error, rather than reading outside of the mapped file
+	uint8 PastEnd = 0;
+	Reader.Seek(Data.Num());
+	Reader.Serialize(&PastEnd, 1);
+	TestTrue(TEXT("Reading past the end is an error"), Reader.IsError());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameIncrementalCacheTest, "SaveGamePlugin.IncrementalCache", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameIncrementalCacheTest::RunTest(const FString& Parameters)
+{
+	SaveGameTests::FTestWorld TestWorld;
+
+	AActor* ActorA = TestWorld.World->SpawnActor<ASaveGameBenchmarkActor>();
+	AActor* ActorB = TestWorld.World->SpawnActor<ASaveGameBenchmarkActor>();
+
+	const TArray<uint8> DataA = { 1, 2, 3 };
+	const TArray<uint8> DataB = { 4, 5 };
+
+	FSaveGameIncrementalCache Cache;
+	auto IsCached = [&Cache](const AActor* Actor, const TArray<uint8>& Data)
+	{
+		return TArray<uint8>(Cache.FindData(Actor)) == Data;
+	};
+
+	Cache.AddData(ActorA, DataA);
+	Cache.AddData(ActorB, DataB);
+
+	TestTrue(TEXT("Cached data is reused"), IsCached(ActorA, DataA) && IsCached(ActorB, DataB));
+
+	Cache.Invalidate(ActorA);
+	TestTrue(TEXT("Invalidated data isn't reused"), Cache.FindData(ActorA).IsEmpty());
+	TestFalse(TEXT("Other actors are still reused"), Cache.FindData(ActorB).IsEmpty());
+
+	Cache.AddData(ActorA, DataA);
+	ActorA->SetActorLocation(FVector(100.0, 0.0, 0.0));
+	TestTrue(TEXT("Moving an actor invalidates its data"), Cache.FindData(ActorA).IsEmpty());
+	TestFalse(TEXT("Moving an actor doesn't invalidate others"), Cache.FindData(ActorB).IsEmpty());
+
+	// Data that's cached again is bound to the actor moving again
+	Cache.AddData(ActorA, DataB);
+	TestTrue(TEXT("Replaced data is reused"), IsCached(ActorA, DataB));
+
+	ActorA->SetActorLocation(FVector(200.0, 0.0, 0.0));
+	TestTrue(TEXT("Moving an actor invalidates its replaced data"), Cache.FindData(ActorA).IsEmpty());
+
+	Cache.Reset();
+	TestTrue(TEXT("Reset forgets everything"), Cache.FindData(ActorB).IsEmpty());
+
+	// Nothing should be listening once the cache has been reset
+	ActorB->SetActorLocation(FVector(300.0, 0.0, 0.0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameRoundTripTest, "SaveGamePlugin.RoundTrip", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameRoundTripTest::RunTest(const FString& Parameters)
+{
+	SaveGameTests::FTestWorld TestWorld;
+
+	FRandomStream Random(1);
+	TestWorld.SpawnActors(Random);
+
+	const TMap<FString, SaveGameTests::FActorState> Expected = SaveGameTests::CaptureActors(TestWorld.World);
+
+	if (!TestTrue(TEXT("Saved"), TestWorld.Save()))
+	{
+		return false;
+	}
+
+	TestWorld.DestroyActors();
+
+	if (!TestTrue(TEXT("Loaded"), TestWorld.Load()))
+	{
+		return false;
+	}
+
+	SaveGameTests::TestActorsEqual(*this, Expected, SaveGameTests::CaptureActors(TestWorld.World));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameIncrementalRoundTripTest, "SaveGamePlugin.IncrementalRoundTrip", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameIncrementalRoundTripTest::RunTest(const FString& Parameters)
+{
+	const SaveGameTests::FScopedSetting IncrementalSaves(TEXT("bIncrementalSaves"), true);
+	SaveGameTests::FTestWorld TestWorld;
+
+	FRandomStream Random(2);
+	TArray<ASaveGameBenchmarkActor*> Actors = TestWorld.SpawnActors(Random);
+
+	// The first save fills the cache, which the second save reuses for all but the actors that changed
+	if (!TestTrue(TEXT("Saved"), TestWorld.Save()))
+	{
+		return false;
+	}
+
+	Actors[0]->Health += 1;
+	USaveGameFunctionLibrary::MarkActorSaveDirty(Actors[0]);
+
+	Actors[1]->SetActorLocation(FVector(1.0, 2.0, 3.0));
+
+	// Adds to the name table that the cached data indexes into
+	Actors[2]->State = TEXT("NewState");
+	USaveGameFunctionLibrary::MarkActorSaveDirty(Actors[2]);
+
+	const TMap<FString, SaveGameTests::FActorState> Expected = SaveGameTests::CaptureActors(TestWorld.World);
+
+	if (!TestTrue(TEXT("Saved incrementally"), TestWorld.Save()))
+	{
+		return false;
+	}
+
+	TestWorld.DestroyActors();
+
+	if (!TestTrue(TEXT("Loaded"), TestWorld.Load()))
+	{
+		return false;
+	}
+
+	SaveGameTests::TestActorsEqual(*this, Expected, SaveGameTests::CaptureActors(TestWorld.World));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveGameBenchmarkThresholdsTest, "SaveGamePlugin.BenchmarkThresholds", SAVEGAME_TEST_FLAGS)
+
+bool FSaveGameBenchmarkThresholdsTest::RunTest(const FString& Parameters)
+{
+	const TMap<FString, double> Thresholds = USaveGameBenchmarkCommandlet::ParseThresholds(TEXT("-Iterations=2 -Thresholds=Save.Actors=50,Load.Total=200 -Seed=1"));
+
+	TestEqual(TEXT("Number of thresholds"), Thresholds.Num(), 2);
+	TestEqual(TEXT("Save.Actors"), Thresholds.FindRef(TEXT("Save.Actors")), 50.0);
+	TestEqual(TEXT("Load.Total"), Thresholds.FindRef(TEXT("Load.Total")), 200.0);
+	TestTrue(TEXT("No thresholds"), USaveGameBenchmarkCommandlet::ParseThresholds(TEXT("-Iterations=2")).IsEmpty());
+
+	// Averages of 40ms for saving actors, and 150ms in total for loading
+	FSaveGameBenchmarkPass SavePass{ TEXT("Save") };
+	FSaveGameBenchmarkPass LoadPass{ TEXT("Load") };
+
+	for (const double ActorsSeconds : { 0.030, 0.050 })
+	{
+		FSaveGamePhaseStats& SaveStats = SavePass.Iterations.AddDefaulted_GetRef();
+		SaveStats.Seconds[static_cast<int32>(ESaveGamePhase::Actors)] = ActorsSeconds;
+		SaveStats.Seconds[static_cast<int32>(ESaveGamePhase::Compress)] = 0.010;
+
+		FSaveGamePhaseStats& LoadStats = LoadPass.Iterations.AddDefaulted_GetRef();
+		LoadStats.Seconds[static_cast<int32>(ESaveGamePhase::Decompress)] = 0.050;
+		LoadStats.Seconds[static_cast<int32>(ESaveGamePhase::Actors)] = 0.100;
+	}
+
+	TestEqual(TEXT("Passes"), USaveGameBenchmarkCommandlet::CountExceededThresholds(Thresholds, SavePass, LoadPass), 0);
+
+	AddExpectedError(TEXT("over its threshold"), EAutomationExpectedErrorFlags::Contains, 2);
+	const TMap<FString, double> ExceededThresholds = USaveGameBenchmarkCommandlet::ParseThresholds(TEXT("-Thresholds=Save.Actors=39.9,Save.Total=50,Load.Total=149"));
+	TestEqual(TEXT("Fails"), USaveGameBenchmarkCommandlet::CountExceededThresholds(ExceededThresholds, SavePass, LoadPass), 2);
+
+	// Thresholds that don't match a pass and phase are skipped, rather than failing the run
+	AddExpectedError(TEXT("Unknown threshold"), EAutomationExpectedErrorFlags::Contains, 3);
+	const TMap<FString, double> UnknownThresholds = USaveGameBenchmarkCommandlet::ParseThresholds(TEXT("-Thresholds=Save.Bogus=0,Bogus.Actors=0,Load=0"));
+	TestEqual(TEXT("Unknown thresholds are skipped"), USaveGameBenchmarkCommandlet::CountExceededThresholds(UnknownThresholds, SavePass, LoadPass), 0);
+
+	return true;
+}
+
+#undef SAVEGAME_TEST_SAVE_NAME
+#undef SAVEGAME_TEST_FLAGS
+
+#endif
@@ -3,11 +3,50 @@
 #pragma once
 
 #include "SaveGameObject.h"
+#include "SaveGameSettings.h"
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "SaveGameFunctionLibrary.generated.h"
 
+/** What's in a save slot's header, which can be read without reading the rest of the save */
+USTRUCT(BlueprintType)
+struct FSaveGameSlotInfo
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	FString SlotName;
+
+	/** The package name of the map that the slot was saved in */
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	FString MapName;
+
+	/** When the slot was saved, in UTC */
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	FDateTime Timestamp;
+
+	/** How long the game had been played for, see USaveGameSubsystem::GetPlaySeconds */
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	double PlaySeconds = 0.0;
+
+	/** The game's own key/values, see USaveGameSubsystem::SetSlotUserData */
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	TMap<FString, FString> UserData;
+
+	/** The size of the save once decompressed */
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	int64 UncompressedSize = 0;
+
+	/** The size of the save's compressed blocks */
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	int64 CompressedSize = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Slot")
+	ESaveGameCompressionCodec Codec = ESaveGameCompressionCodec::None;
+};
+
 UCLASS()
 class SAVEGAMEPLUGIN_API USaveGameFunctionLibrary : public UBlueprintFunctionLibrary
 {
@@ -23,6 +62,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Utilities")
 	static bool WasObjectLoaded(const UObject* Object);
 
+	/**
+	 * Marks an actor as changed for the next incremental save, see USaveGameSubsystem::MarkSaveDirty. Meant to be
+	 * called from the setters of an actor's SaveGame properties, which don't have the subsystem at hand.
+	 * 
+	 * @param Actor The actor whose saved state has changed
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Utilities", meta=(DefaultToSelf="Actor"))
+	static void MarkActorSaveDirty(AActor* Actor);
+
 	/**
 	 * Check to see if the current save game is loading the archive.
 	 * 
@@ -70,4 +118,28 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Serialize")
 	static int32 UseCustomVersion(UPARAM(ref) FSaveGameArchive& Archive, const UEnum* VersionEnum);
+
+	/**
+	 * Finds every save slot, reading only the header of each slot rather than the whole save. Headers are read in
+	 * parallel when saves are files on disk, otherwise each save is read in full through the platform's
+	 * ISaveGameSystem, one at a time. Call this from the game thread.
+	 * 
+	 * @return The slots that could be read, the most recently saved first
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Slots")
+	static TArray<FSaveGameSlotInfo> FindSaveSlots();
+
+	/**
+	 * Reads only the header of a save slot, if saves are files on disk. Call this from the game thread, or from a worker
+	 * thread if saves are files or the platform's ISaveGameSystem can be read from other threads.
+	 * 
+	 * @param SlotName The slot to read
+	 * @param OutSlot The slot's header
+	 * @return false if the slot doesn't exist, or isn't a save that can be read
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Slots")
+	static bool PeekSaveSlot(const FString& SlotName, FSaveGameSlotInfo& OutSlot);
+
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Slots")
+	static bool DeleteSaveSlot(const FString& SlotName);
 };
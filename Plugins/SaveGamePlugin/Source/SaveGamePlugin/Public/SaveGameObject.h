@@ -14,6 +14,9 @@
  * field names and their offsets, if loading, it will automatically seek to the very end of the archive. The initial
  * position and stored offsets can be used for out-of-order seeking to each of the archive's serialized fields.
  *
+ * The fields are kept in a flat array (inline for the first few fields), sorted by name so that they can be found
+ * with a binary search. Offsets are stored as 32 bits, relative to the archive's initial position.
+ *
  * Additionally, when loading, these field names are checked against CoreRedirects and redirected if needed.
  */
 USTRUCT(BlueprintType, BlueprintInternalUseOnly)
@@ -27,9 +30,14 @@ public:
 		, Object(nullptr)
 		, StartPosition(0)
 		, EndPosition(0)
+		, SpawnTransform(nullptr)
 	{}
 
-	FSaveGameArchive(class FStructuredArchive::FRecord& InRecord, UObject* InObject);
+	/**
+	 * @param InFieldRedirects When loading, remembers the field redirects found for the object's class, so that they're
+	 *                         only looked up once across a load's actors
+	 */
+	FSaveGameArchive(class FStructuredArchive::FRecord& InRecord, UObject* InObject, struct FSaveGameFieldRedirects* InFieldRedirects = nullptr);
 	~FSaveGameArchive();
 
 	bool IsValid() const
@@ -42,6 +50,27 @@ public:
 		return *Record;
 	}
 
+	/** The object whose data this archive holds */
+	UObject* GetObject() const
+	{
+		return Object.Get();
+	}
+
+	/**
+	 * When loading an actor whose spawning was deferred (see USaveGameSettings::bDeferSpawnedActors), this is where
+	 * its transform should be written to, as the actor will finish spawning with it once it has been loaded.
+	 * Only applies to the archive's own object, see GetObject.
+	 */
+	FTransform* GetSpawnTransform() const
+	{
+		return SpawnTransform;
+	}
+
+	void SetSpawnTransform(FTransform* InSpawnTransform)
+	{
+		SpawnTransform = InSpawnTransform;
+	}
+
 	/**
 	 * Serializes a field with a custom lambda function. If a binary format, stores its offset for out-of-order reading.
 	 * @param FieldName Name of the field that's being serialized
@@ -58,28 +87,23 @@ public:
 
 		FArchive& Archive = Record->GetUnderlyingArchive();
 
-		if (Archive.IsSaving() && Fields.Contains(FieldName))
-		{
-			// We don't want to double up on saving the same property
-			return false;
-		}
-
 		// Text formats don't deal with seeking very well
 		if (!Archive.IsTextFormat())
 		{
 			if (Archive.IsLoading())
 			{
-				if (!Fields.Contains(FieldName))
+				const uint32* FieldOffset = FindField(FieldName);
+				if (!FieldOffset)
 				{
 					return false;
 				}
 
-				Archive.Seek(StartPosition + Fields[FieldName]);
+				Archive.Seek(StartPosition + *FieldOffset);
 			}
-			else
+			else if (!AddField(FieldName, Archive.Tell() - StartPosition))
 			{
-				// Use an offset, in case we need to shuffle data around later!
-				Fields.Add(FieldName, Archive.Tell() - StartPosition);
+				// We don't want to double up on saving the same property
+				return false;
 			}
 		}
 
@@ -89,15 +113,40 @@ public:
 	}
 	
 private:
+	// TSaveGameSerializer::ReadSizeProfile measures each field from its offset
+	template<bool, bool> friend class TSaveGameSerializer;
+
 	FSaveGameArchive(FSaveGameArchive&) = delete;
+
+	/** A serialized field, and its offset from the start of this archive */
+	struct FFieldOffset
+	{
+		FName Name;
+		uint32 Offset;
+
+		friend FArchive& operator<<(FArchive& Ar, FFieldOffset& Field)
+		{
+			return Ar << Field.Name << Field.Offset;
+		}
+	};
+
+	/** Finds the offset of a field, or null if it wasn't serialized */
+	const uint32* FindField(FName FieldName) const;
+
+	/**
+	 * Adds a field at an offset (use an offset, in case we need to shuffle data around later!)
+	 * @return false if the field has already been added
+	 */
+	bool AddField(FName FieldName, uint64 Offset);
 	
 	class FStructuredArchive::FRecord* Record;
 	TWeakObjectPtr<> Object;
 	uint64 StartPosition;
 	uint64 EndPosition;
+	FTransform* SpawnTransform;
 
-	/** This serialized fields and their offsets from the start of this archive */
-	TMap<FName, uint64> Fields;
+	/** This serialized fields and their offsets from the start of this archive, sorted by name */
+	TArray<FFieldOffset, TInlineAllocator<8>> Fields;
 };
 
 // Ensure that our archive can't be copied
@@ -135,6 +184,16 @@ public:
 	 */
 	UFUNCTION(BlueprintNativeEvent, Category=SaveGame)
 	bool OnSerialize(UPARAM(ref) FSaveGameArchive& Archive, bool bIsLoading);
+
+	/**
+	 * Native classes can override this to have their SaveGame properties and OnSerialize saved on a worker thread,
+	 * in parallel with other actors. Only return true if OnSerialize doesn't touch anything that the game thread or
+	 * other actors could be modifying at the same time.
+	 *
+	 * This is checked once per class on its class default object, and is ignored if OnSerialize is overridden in a
+	 * Blueprint. Loading always happens on the game thread.
+	 */
+	virtual bool CanSerializeOnAnyThread() const { return false; }
 };
 
 UINTERFACE(MinimalAPI)
@@ -3,3 +3,5 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+SAVEGAMEPLUGIN_API DECLARE_LOG_CATEGORY_EXTERN(LogSaveGame, Log, All);
@@ -0,0 +1,59 @@
+// Copyright Alex Stevens (@MilkyEngineer). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGameObject.h"
+#include "Templates/PimplPtr.h"
+
+template<bool, bool> class TSaveGameSerializer;
+
+/**
+ * Reads individual actors out of a save, without loading it (no travelling or spawning).
+ * Useful for showing information about a save in a menu, like the player's inventory or stats.
+ *
+ * Uses the save's actor index to seek straight to an actor's record, then provides the data that the actor wrote in
+ * ISaveGameObject::OnSerialize as an FSaveGameArchive, which can be read with FSaveGameArchive::SerializeField.
+ */
+class SAVEGAMEPLUGIN_API FSaveGameReader
+{
+public:
+	FSaveGameReader();
+	~FSaveGameReader();
+
+	/**
+	 * Reads and decompresses a save.
+	 *
+	 * Call this from the game thread. A worker thread also works, as LoadAsync does, if the platform's ISaveGameSystem
+	 * can be read from other threads. CoreRedirects also mustn't change while the save's paths are fixed up.
+	 *
+	 * @param SaveName The name of the save to read
+	 * @return false if the save doesn't exist, or couldn't be read
+	 */
+	bool Open(const FString& SaveName = TEXT("SaveGame"));
+
+	bool IsOpen() const { return bIsOpen; }
+
+	/** The package name of the map that the save belongs to */
+	const FString& GetMapName() const;
+
+	bool ContainsActor(const FName ActorName) const;
+	bool ContainsActor(const FGuid& SpawnID) const;
+
+	/**
+	 * Reads an actor's data from the save.
+	 *
+	 * @param ActorName The object name of the actor that was saved
+	 * @param ReadFunction Reads fields out of the data that the actor wrote in ISaveGameObject::OnSerialize
+	 * @param PropertiesTarget If set, the actor's SaveGame properties are read into this object (on the game thread)
+	 * @return true if the save has the actor, and it was read successfully
+	 */
+	bool ReadActor(const FName ActorName, TFunctionRef<void(FSaveGameArchive&)> ReadFunction, UObject* PropertiesTarget = nullptr);
+
+	/** Reads the data of an actor that implements ISaveGameSpawnActor (i.e. the player's character) */
+	bool ReadActor(const FGuid& SpawnID, TFunctionRef<void(FSaveGameArchive&)> ReadFunction, UObject* PropertiesTarget = nullptr);
+
+private:
+	TPimplPtr<TSaveGameSerializer<true, false>> Serializer;
+	bool bIsOpen;
+};
@@ -6,6 +6,62 @@
 #include "Engine/DeveloperSettings.h"
 #include "SaveGameSettings.generated.h"
 
+/** The kind of save being made, used to select how the save is written */
+UENUM(BlueprintType)
+enum class ESaveGameType : uint8
+{
+	Manual,
+	Autosave,
+	Quicksave,
+	Checkpoint
+};
+
+/** The codec used to compress a save. Stored in the save's file header, so changing this won't break older saves. */
+UENUM(BlueprintType)
+enum class ESaveGameCompressionCodec : uint8
+{
+	None,
+	Oodle,
+	LZ4,
+	Zlib,
+	Gzip
+};
+
+/** A codec agnostic compression level, trading speed for compression ratio */
+UENUM()
+enum class ESaveGameCompressionLevel : uint8
+{
+	Fastest,
+	Fast,
+	Normal,
+	Optimal,
+	Maximum
+};
+
+USTRUCT()
+struct FSaveGameCompressionSettings
+{
+	GENERATED_BODY()
+
+public:
+	FSaveGameCompressionSettings()
+		: Codec(ESaveGameCompressionCodec::Oodle)
+		, Level(ESaveGameCompressionLevel::Normal)
+	{}
+
+	FSaveGameCompressionSettings(ESaveGameCompressionCodec InCodec, ESaveGameCompressionLevel InLevel)
+		: Codec(InCodec)
+		, Level(InLevel)
+	{}
+
+	UPROPERTY(EditAnywhere)
+	ESaveGameCompressionCodec Codec;
+
+	/** Selects the Oodle compressor and level. Other codecs only use this as a hint to bias for speed or size. */
+	UPROPERTY(EditAnywhere, meta=(EditCondition="Codec != ESaveGameCompressionCodec::None"))
+	ESaveGameCompressionLevel Level;
+};
+
 USTRUCT(BlueprintType, BlueprintInternalUseOnly)
 struct FSaveGameVersionInfo
 {
@@ -32,7 +88,25 @@ class SAVEGAMEPLUGIN_API USaveGameSettings : public UDeveloperSettings
 	GENERATED_BODY()
 
 public:
+	USaveGameSettings();
+	
 	FGuid GetVersionId(const UEnum* VersionEnum) const;
+	FSaveGameCompressionSettings GetCompressionSettings(ESaveGameType SaveType) const;
+	int32 GetCompressionBlockSize() const { return CompressionBlockSizeKB * 1024; }
+
+	int32 GetMaxPendingAsyncSaves() const { return MaxPendingAsyncSaves; }
+
+	bool UseIncrementalSaves() const { return bIncrementalSaves; }
+	int32 GetIncrementalSaveFlushInterval() const { return IncrementalSaveFlushInterval; }
+
+	bool ShouldStreamSaves() const { return bStreamSaves; }
+	int32 GetMaxStreamingBlocks() const { return MaxStreamingBlocks; }
+
+	bool ShouldDeferSpawnedActors() const { return bDeferSpawnedActors; }
+	bool ShouldBatchLoadReferences() const { return bBatchLoadReferences; }
+
+	bool ShouldStreamLoads() const { return bStreamLoads; }
+	int32 GetLoadStreamingBlocks() const { return LoadStreamingBlocks; }
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -46,6 +120,94 @@ protected:
 	UPROPERTY(EditAnywhere, Config, Category=Version)
 	TArray<FSaveGameVersionInfo> Versions;
 
+	/**
+	 * The maximum number of asynchronous saves that can be compressing or writing at any one time.
+	 * Any calls to USaveGameSubsystem::SaveAsync past this limit will fail.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Save, meta=(ClampMin=1))
+	int32 MaxPendingAsyncSaves = 2;
+
+	/**
+	 * Whether saves reuse the data of actors that haven't changed since the previous save, rather than serializing
+	 * them again. Actors are automatically marked dirty when their root component moves, any other change (to their
+	 * SaveGame properties, or what they write in OnSerialize) needs USaveGameSubsystem::MarkSaveDirty to be called.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Save)
+	bool bIncrementalSaves = false;
+
+	/**
+	 * How many incremental saves can be made before the next save is a full save.
+	 * Full saves drop any names and paths that were only used by actors that no longer exist.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Save, meta=(ClampMin=1, EditCondition="bIncrementalSaves"))
+	int32 IncrementalSaveFlushInterval = 16;
+
+	/**
+	 * Whether saves are compressed and written to disk block by block while the world is being serialized, rather than
+	 * holding the whole save (and its compressed copy) in memory until it's written.
+	 *
+	 * Streamed saves are written straight to the project's SaveGames directory, rather than through the platform's
+	 * save game system, so this is ignored on platforms whose save game system isn't file based.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Save)
+	bool bStreamSaves = false;
+
+	/**
+	 * When streaming saves, the number of blocks that can be waiting to be compressed or written at once. Serializing
+	 * the world waits for a block to be written when this is reached, so this bounds a save's memory to roughly this
+	 * many blocks (of CompressionBlockSizeKB), plus the largest actor.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Save, meta=(ClampMin=1, EditCondition="bStreamSaves"))
+	int32 MaxStreamingBlocks = 4;
+
+	/**
+	 * Whether actors that are spawned when loading have their saved state applied before they finish spawning, so
+	 * that construction scripts and BeginPlay only run once, with the loaded state. As OnSerialize is then called
+	 * before the actor's components are registered, it should only restore state (use SerializeActorTransform for the
+	 * transform), and leave anything that needs a registered component (i.e. physics) to BeginPlay.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Load)
+	bool bDeferSpawnedActors = false;
+
+	/**
+	 * Whether the assets referenced by a save are loaded in the same batch as the classes of its spawned actors, before
+	 * any actor is loaded. References that still can't be resolved are then left empty, rather than each one being
+	 * loaded synchronously as it's serialized.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Load)
+	bool bBatchLoadReferences = false;
+
+	/**
+	 * Whether loads memory map the save file and decompress each block as it's read, rather than reading and
+	 * decompressing the whole save up front and holding on to it while travelling to the save's map.
+	 *
+	 * Like bStreamSaves, the save is mapped from the project's SaveGames directory. If it isn't there (or the platform
+	 * can't map files), the save is read through the platform's save game system as usual.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Load)
+	bool bStreamLoads = false;
+
+	/**
+	 * When streaming loads, the number of decompressed blocks that are kept in memory. Blocks are the size that the
+	 * save was written with (CompressionBlockSizeKB at the time), which is stored in its header.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Load, meta=(ClampMin=1, EditCondition="bStreamLoads"))
+	int32 LoadStreamingBlocks = 4;
+
+	/**
+	 * How each kind of save is compressed. By default, saves that happen in the background favour speed,
+	 * and saves that the player explicitly makes favour compression ratio.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Compression)
+	TMap<ESaveGameType, FSaveGameCompressionSettings> Compression;
+
+	/**
+	 * Saves are split into blocks of this size (in kilobytes), which are compressed and decompressed in parallel.
+	 * Smaller blocks spread across more cores, larger blocks compress better.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category=Compression, meta=(ClampMin=16, ClampMax=65536))
+	int32 CompressionBlockSizeKB = 256;
+
 private:
 	mutable TMap<TObjectPtr<UEnum>, FGuid> CachedVersions;
 };
@@ -3,9 +3,78 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SaveGameSettings.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
 #include "SaveGameSubsystem.generated.h"
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnSaveGameCompleted, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSaveGameLoaded, bool, bSuccess);
+
+/**
+ * How long the most recent saves and loads took, and how big they were. Also printed by the SaveGame.Stats command.
+ */
+USTRUCT(BlueprintType)
+struct FSaveGameStats
+{
+	GENERATED_BODY()
+
+public:
+	/** The time taken by the last save, including compressing and writing */
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	float LastSaveSeconds = 0.f;
+
+	/** The longest time taken by any save */
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	float PeakSaveSeconds = 0.f;
+
+	/** The time that the last save blocked the game thread for, which is less than LastSaveSeconds if it was async */
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	float LastSaveGameThreadSeconds = 0.f;
+
+	/** The size of the last save before compression */
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	int64 LastSaveBytesSerialized = 0;
+
+	/** The size of the last save once compressed */
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	int64 LastSaveBytesWritten = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	int32 LastSaveActors = 0;
+
+	/** LastSaveBytesWritten over LastSaveBytesSerialized, lower is better */
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	float LastCompressionRatio = 0.f;
+
+	/** The time taken by the last load, not including travelling to the save's map */
+	UPROPERTY(BlueprintReadOnly, Category="Load")
+	float LastLoadSeconds = 0.f;
+
+	/** The longest time taken by any load */
+	UPROPERTY(BlueprintReadOnly, Category="Load")
+	float PeakLoadSeconds = 0.f;
+
+	/** The size of the last save that was loaded, as it was on disk */
+	UPROPERTY(BlueprintReadOnly, Category="Load")
+	int64 LastLoadBytesRead = 0;
+
+	/** The size of the last save that was loaded, once decompressed */
+	UPROPERTY(BlueprintReadOnly, Category="Load")
+	int64 LastLoadBytesSerialized = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Load")
+	int32 LastLoadActors = 0;
+
+	/** The number of successful saves */
+	UPROPERTY(BlueprintReadOnly, Category="Save")
+	int32 NumSaves = 0;
+
+	/** The number of successful loads */
+	UPROPERTY(BlueprintReadOnly, Category="Load")
+	int32 NumLoads = 0;
+};
+
 /**
  * The subsystem that manages the lifetime of a save game.
  */
@@ -18,30 +87,155 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
+	/**
+	 * @param SaveType The kind of save, which selects how the save is compressed
+	 * @param SlotName The slot to save to, which is replaced if it already exists
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Save")
+	bool Save(ESaveGameType SaveType = ESaveGameType::Manual, const FString& SlotName = TEXT("SaveGame"));
+
+	/**
+	 * Serializes the world on the game thread, then compresses the save on a worker thread. The save is written from a
+	 * worker thread too if the platform keeps saves as plain files, otherwise it's written on the game thread, as the
+	 * platform's save game system may not be thread safe.
+	 *
+	 * @param SaveType The kind of save, which selects how the save is compressed
+	 * @param OnCompleted Called on the game thread once the save has been written
+	 * @param SlotName The slot to save to, which is replaced if it already exists
+	 * @return false if the save couldn't be started (i.e. too many saves already in flight)
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Save", meta=(AutoCreateRefTerm="OnCompleted"))
+	bool SaveAsync(ESaveGameType SaveType, const FOnSaveGameCompleted& OnCompleted, const FString& SlotName = TEXT("SaveGame"));
+
 	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Save")
-	bool Save();
+	bool IsSavingSaveGame() const;
+
+	/**
+	 * With incremental saves enabled, marks an actor as changed so that it's serialized again in the next save,
+	 * rather than reusing its data from the previous save. Moving the actor's root component marks it automatically,
+	 * anything else that changes what the actor saves needs to call this: its SaveGame property setters (see
+	 * USaveGameFunctionLibrary::MarkActorSaveDirty), and whatever changes the data it writes in OnSerialize.
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Save", meta=(DefaultToSelf="Actor"))
+	void MarkSaveDirty(AActor* Actor);
 
 	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Load")
-	bool Load();
+	bool Load(const FString& SlotName = TEXT("SaveGame"));
+
+	/**
+	 * Reads and decompresses the save on a worker thread while travelling to the save's map.
+	 *
+	 * @param SlotName The slot to load, see USaveGameFunctionLibrary::FindSaveSlots
+	 * @return false if the load couldn't be started (i.e. the save doesn't exist)
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Load")
+	bool LoadAsync(const FString& SlotName = TEXT("SaveGame"));
 	
 	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Load")
 	bool IsLoadingSaveGame() const;
 
+	/** Broadcast when a load that has started (see Load and LoadAsync) completes, or fails part way through */
+	UPROPERTY(BlueprintAssignable, Category="SaveGamePlugin|Load")
+	FOnSaveGameLoaded OnSaveGameLoaded;
+
+	/** The slot that was most recently saved to or loaded, empty if there hasn't been one */
+	UFUNCTION(BlueprintPure, Category="SaveGamePlugin|Slots")
+	const FString& GetCurrentSlot() const { return CurrentSlot; }
+
+	/**
+	 * Stores a key/value in the header of every subsequent save, so that it can be shown without loading the save
+	 * (see USaveGameFunctionLibrary::FindSaveSlots), i.e. the chapter name. Loading a slot restores its key/values.
+	 */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Slots")
+	void SetSlotUserData(const FString& Key, const FString& Value);
+
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Slots")
+	void RemoveSlotUserData(const FString& Key);
+
+	UFUNCTION(BlueprintPure, Category="SaveGamePlugin|Slots")
+	const TMap<FString, FString>& GetSlotUserData() const { return SlotUserData; }
+
+	/**
+	 * How long the game has been played for, which is stored in each save's header. Counts real time since the game
+	 * instance started (or since the last load, which carries on from the loaded save's play time).
+	 */
+	UFUNCTION(BlueprintPure, Category="SaveGamePlugin|Slots")
+	double GetPlaySeconds() const;
+
+	/** Restarts the play time from a value, i.e. zero when starting a new game */
+	UFUNCTION(BlueprintCallable, Category="SaveGamePlugin|Slots")
+	void SetPlaySeconds(double PlaySeconds);
+
+	/** How long the most recent saves and loads took, and how big they were */
+	UFUNCTION(BlueprintPure, Category="SaveGamePlugin|Stats")
+	const FSaveGameStats& GetStats() const { return Stats; }
+
 protected:
 	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues);
 	void OnActorsInitialized(const FActorsInitializedParams& Params);
 	void OnWorldCleanup(UWorld* World, bool, bool);
+
+	/** Loads the streaming level's chunk (if it has one), now that its actors exist */
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	
+	/** Saves the streaming level's actors into a chunk, before they're unloaded */
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+	/** Loads a streaming level's chunk (if it has one) once its classes have loaded in the background */
+	void LoadLevelChunk(ULevel* Level);
 	
 	void OnActorPreSpawn(AActor* Actor);
 	void OnActorDestroyed(AActor* Actor);
 
-	void OnLoadCompleted();
+	void OnSaveCompleted(bool bSuccess, const FOnSaveGameCompleted& OnCompleted);
+	void OnLoadCompleted(bool bSuccess);
 
 private:
 	template<bool, bool> friend class TSaveGameSerializer;
 
 	TSharedPtr<class FSaveGameSerializer, ESPMode::ThreadSafe> CurrentSerializer;
+
+	/** The task of the most recent async save, subsequent saves will wait on this before writing */
+	UE::Tasks::FTask LastSaveTask;
+	int32 NumPendingSaves = 0;
+
+	/**
+	 * When the platform's save game system can only be used from the game thread, the async saves that are waiting
+	 * to be written once their task (which compresses them) completes, in the order they were made.
+	 */
+	TArray<TPair<TSharedPtr<FSaveGameSerializer, ESPMode::ThreadSafe>, UE::Tasks::FTask>> PendingWrites;
+
+	/** Writes the pending saves whose tasks have completed, or all of them (waiting on their tasks) if bWait */
+	void WritePendingSaves(bool bWait = false);
+
+	/** Blocks until every async save has been written */
+	void WaitForAsyncSaves();
 	
-	TSet<TWeakObjectPtr<AActor>> SaveGameActors;
+	/** The actors that implement ISaveGameObject */
+	TSharedPtr<struct FSaveGameActorRegistry> ActorRegistry;
 	TSet<FSoftObjectPath> DestroyedLevelActors;
+
+	/** The chunks of streaming levels that aren't currently loaded, keyed by GetLevelChunkName */
+	TMap<FName, TArray<uint8>> LevelChunks;
+
+	/** The serializers of loaded streaming levels whose chunk is waiting on its classes to load, see LoadLevelChunk */
+	TMap<FName, TSharedPtr<FSaveGameSerializer, ESPMode::ThreadSafe>> PendingLevelChunks;
+
+	/** The name a level's chunk is stored under, the package name without any PIE prefix */
+	static FName GetLevelChunkName(const FString& PackageName);
+
+	/** Each actor's data from the previous save, for incremental saves */
+	TSharedPtr<struct FSaveGameIncrementalCache> IncrementalCache;
+
+	/** Updated by the serializer whenever a save or load completes */
+	FSaveGameStats Stats;
+
+	FString CurrentSlot;
+	TMap<FString, FString> SlotUserData;
+
+	/** The play time when PlayStartTime was taken */
+	double PlaySecondsOffset = 0.0;
+	double PlayStartTime = 0.0;
+
+	static bool IsValidSlotName(const FString& SlotName);
 };
@@ -10,9 +10,47 @@ class SAVEGAMEPLUGIN_API FSaveGameVersion
 public:
 	enum Type
 	{
+		// Added an uncompressed file header that contains the map name, so it can be read before decompressing
+		AddedFileHeader,
+
+		// Actors are now stored as a list of records, and names are stored once in a name table
+		AddedNameTable,
+
+		// Soft object paths (and object references) are stored once in a path table
+		AddedPathTable,
+
+		// The compression codec is selectable, and is stored in the file header along with the uncompressed size
+		AddedCompressionCodec,
+
+		// Saves are compressed in independent blocks, with a block table in the file header
+		AddedCompressionBlocks,
+
+		// Added an index of actor records, and each actor's data stores where its OnSerialize data starts
+		AddedActorIndex,
+
+		// Streaming levels are saved into chunks of their own, which are only loaded with their level
+		AddedLevelChunks,
+
+		// The actor index stores each actor's class, so actors can be spawned without reading the actor records
+		AddedIndexClasses,
+
+		// FSaveGameArchive field tables store 32 bit offsets
+		CompactFieldTables,
+
+		// Table offsets are in a footer at the end of the save data, and the block table is after the compressed blocks,
+		// so that a save can be written front to back as it's compressed
+		StreamedSaves,
+
+		// The file header's fixed size fields come first, followed by the slot's metadata (when it was saved, play
+		// time and user data), so that slots can be listed by only reading their headers
+		AddedSlotMetadata,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
-		LatestVersion = VersionPlusOne - 1
+		LatestVersion = VersionPlusOne - 1,
+
+		// Saves older than this can't be loaded. Bump this whenever a format change can't read older saves
+		OldestSupportedVersion = StreamedSaves
 	};
 	
 	const static FGuid GUID;